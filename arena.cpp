@@ -0,0 +1,197 @@
+//-----------------------------------------------------------------------//
+// ARENA.CPP                                                             //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// Arena is a slab allocator for the Nodes and NodeDatas of a BinTree    //
+//-----------------------------------------------------------------------//
+// Slab allocator:  memory is carved off large slabs in allocation order,//
+//       so objects allocated together sit next to each other in memory. //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- a block too large for the free lists gets its own slab, and is   //
+//      only given back by release()                                     //
+//-----------------------------------------------------------------------//
+
+#include "arena.h"
+#include <new>
+
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class Arena; slabs are 64 KiB
+// Preconditions:   none
+// Postconditions:
+//       -- an arena holding no slabs is created
+Arena::Arena() {
+	slabs = NULL;
+	cursor = NULL;
+	limit = NULL;
+	slabSize = 64 * 1024;
+	inUse = 0;
+	reserved = 0;
+	for (size_t i = 0; i < SIZECLASSES; i++)
+		freeLists[i] = NULL;
+}
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the size in bytes of each slab
+// Preconditions:   none
+// Postconditions:
+//       -- an arena holding no slabs is created
+Arena::Arena(size_t bytes) {
+	slabs = NULL;
+	cursor = NULL;
+	limit = NULL;
+	slabSize = roundUp(bytes) + roundUp(sizeof(Slab));
+	inUse = 0;
+	reserved = 0;
+	for (size_t i = 0; i < SIZECLASSES; i++)
+		freeLists[i] = NULL;
+}
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class Arena
+// Preconditions:   release works
+// Postconditions:
+//       -- every slab is deallocated
+Arena::~Arena() {
+	release();
+}
+
+//----------------------------- allocate ----------------------------------
+// Returns a block of at least the number of bytes asked for, aligned to
+// 16 bytes; a new slab is only allocated when the current one is full
+// Preconditions:   none
+// Postconditions:  the block stays valid until deallocate or release
+void* Arena::allocate(size_t bytes) {
+	size_t size = roundUp(bytes);
+	inUse += size;
+	size_t sizeClass = size / ALIGN;
+	if (sizeClass < SIZECLASSES && freeLists[sizeClass] != NULL) {
+		FreeBlock* block = freeLists[sizeClass];
+		freeLists[sizeClass] = block->next;
+		return block;
+	}
+	if (size > slabSize - roundUp(sizeof(Slab)))
+		return addSlab(size); //oversized block gets a slab to itself
+	if (cursor == NULL || (size_t)(limit - cursor) < size) {
+		cursor = addSlab(slabSize - roundUp(sizeof(Slab)));
+		limit = cursor + (slabSize - roundUp(sizeof(Slab)));
+	}
+	void* block = cursor;
+	cursor += size;
+	return block;
+}
+
+//---------------------------- deallocate ---------------------------------
+// Returns a block to the arena so a later allocation can reuse it
+// Preconditions:   the block came from allocate with the same size
+// Postconditions:  the block is on the free list for its size
+void Arena::deallocate(void* block, size_t bytes) {
+	if (block == NULL)
+		return;
+	size_t size = roundUp(bytes);
+	inUse -= size;
+	size_t sizeClass = size / ALIGN;
+	if (sizeClass < SIZECLASSES) {
+		FreeBlock* freed = static_cast<FreeBlock*>(block);
+		freed->next = freeLists[sizeClass];
+		freeLists[sizeClass] = freed;
+	}
+}
+
+//----------------------------- release -----------------------------------
+// Frees every slab at once
+// Preconditions:   no block allocated from the arena is still in use
+// Postconditions:  the arena holds no slabs and no free blocks
+void Arena::release() {
+	while (slabs != NULL) {
+		Slab* next = slabs->next;
+		::operator delete(slabs);
+		slabs = next;
+	}
+	cursor = NULL;
+	limit = NULL;
+	inUse = 0;
+	reserved = 0;
+	for (size_t i = 0; i < SIZECLASSES; i++)
+		freeLists[i] = NULL;
+}
+
+//------------------------------ adopt ------------------------------------
+// Takes over every slab and free block of another arena.  Its chains are
+// linked in front of this arena's, and its unused slab space is only
+// kept if this arena has none of its own
+// Preconditions:   the arenas are different
+// Postconditions:  the parameter holds no slabs and no free blocks
+void Arena::adopt(Arena& other) {
+	if (other.slabs != NULL) {
+		Slab* last = other.slabs;
+		while (last->next != NULL)
+			last = last->next;
+		last->next = slabs;
+		slabs = other.slabs;
+	}
+	if (cursor == NULL) {
+		cursor = other.cursor;
+		limit = other.limit;
+	}
+	for (size_t i = 0; i < SIZECLASSES; i++) {
+		if (other.freeLists[i] != NULL) {
+			FreeBlock* last = other.freeLists[i];
+			while (last->next != NULL)
+				last = last->next;
+			last->next = freeLists[i];
+			freeLists[i] = other.freeLists[i];
+			other.freeLists[i] = NULL;
+		}
+	}
+	inUse += other.inUse;
+	reserved += other.reserved;
+	other.slabs = NULL;
+	other.cursor = NULL;
+	other.limit = NULL;
+	other.inUse = 0;
+	other.reserved = 0;
+}
+
+//---------------------------- bytesInUse ---------------------------------
+// Returns the number of bytes handed out and not yet deallocated
+// Preconditions:   none
+// Postconditions:  none
+size_t Arena::bytesInUse() const {
+	return inUse;
+}
+
+//--------------------------- bytesReserved -------------------------------
+// Returns the number of bytes held in slabs
+// Preconditions:   none
+// Postconditions:  none
+size_t Arena::bytesReserved() const {
+	return reserved;
+}
+
+//-----------------------------  roundUp  ---------------------------------
+// rounds a size up to a multiple of ALIGN, at least ALIGN
+// Preconditions:   none
+// Postconditions:  none
+size_t Arena::roundUp(size_t bytes) {
+	if (bytes == 0)
+		return ALIGN;
+	return (bytes + ALIGN - 1) / ALIGN * ALIGN;
+}
+
+//-----------------------------  addSlab  ---------------------------------
+// allocates a slab with room for at least the number of bytes passed and
+// links it into the chain
+// Preconditions:   none
+// Postconditions:  returns the first usable byte of the new slab
+char* Arena::addSlab(size_t bytes) {
+	size_t size = roundUp(sizeof(Slab)) + bytes;
+	Slab* slab = static_cast<Slab*>(::operator new(size));
+	slab->size = size;
+	slab->next = slabs;
+	slabs = slab;
+	reserved += size;
+	return reinterpret_cast<char*>(slab) + roundUp(sizeof(Slab));
+}
@@ -0,0 +1,129 @@
+//-----------------------------------------------------------------------//
+// ARENA.H                                                               //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// Arena is a slab allocator for the Nodes and NodeDatas of a BinTree    //
+//-----------------------------------------------------------------------//
+// Slab allocator:  memory is carved off large slabs in allocation order,//
+//       so objects allocated together sit next to each other in memory. //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- sizes are rounded up to 16 bytes; a freed block goes on a free   //
+//      list for its rounded size and is reused by the next allocation   //
+//      of that size                                                     //
+//   -- release() hands every slab back at once; nothing allocated from  //
+//      the arena may be used afterwards                                 //
+//   -- an Arena is not thread safe and cannot be copied; threads that   //
+//      build one structure can each fill an Arena, then adopt them all  //
+//-----------------------------------------------------------------------//
+
+#ifndef ARENA_H
+#define ARENA_H
+#include <cstddef>
+using namespace std;
+
+
+class Arena {
+public:
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class Arena; slabs are 64 KiB
+// Preconditions:   none
+// Postconditions:
+//       -- an arena holding no slabs is created
+Arena();
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the size in bytes of each slab
+// Preconditions:   none
+// Postconditions:
+//       -- an arena holding no slabs is created
+explicit Arena(size_t);
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class Arena
+// Preconditions:   none
+// Postconditions:
+//       -- every slab is deallocated
+~Arena();
+
+//----------------------------- allocate ----------------------------------
+// Returns a block of at least the number of bytes asked for, aligned to
+// 16 bytes; a new slab is only allocated when the current one is full
+// Preconditions:   none
+// Postconditions:  the block stays valid until deallocate or release
+void* allocate(size_t);
+
+//---------------------------- deallocate ---------------------------------
+// Returns a block to the arena so a later allocation can reuse it
+// Preconditions:   the block came from allocate with the same size
+// Postconditions:  the block is on the free list for its size
+void deallocate(void*, size_t);
+
+//----------------------------- release -----------------------------------
+// Frees every slab at once
+// Preconditions:   no block allocated from the arena is still in use
+// Postconditions:  the arena holds no slabs and no free blocks
+void release();
+
+//------------------------------ adopt ------------------------------------
+// Takes over every slab and free block of another arena, so the blocks
+// allocated from it are now this arena's; lets work on separate threads
+// allocate from arenas of their own and hand the results to one owner
+// Preconditions:   the arenas are different
+// Postconditions:  the parameter holds no slabs and no free blocks
+void adopt(Arena&);
+
+//---------------------------- bytesInUse ---------------------------------
+// Returns the number of bytes handed out and not yet deallocated
+// Preconditions:   none
+// Postconditions:  none
+size_t bytesInUse() const;
+
+//--------------------------- bytesReserved -------------------------------
+// Returns the number of bytes held in slabs
+// Preconditions:   none
+// Postconditions:  none
+size_t bytesReserved() const;
+
+private:
+Arena(const Arena&);            //not copyable
+Arena& operator=(const Arena&); //not assignable
+
+static const size_t ALIGN = 16;      //alignment of every block
+static const size_t SIZECLASSES = 32; //free lists for blocks up to 512B
+
+struct Slab {
+	Slab* next;     //next slab in the chain
+	size_t size;    //bytes in this slab, header included
+};
+
+struct FreeBlock {
+	FreeBlock* next; //next free block of the same size
+};
+
+Slab* slabs;        //chain of every slab, newest first
+char* cursor;       //next unused byte in the newest slab
+char* limit;        //end of the newest slab
+size_t slabSize;    //bytes per regular slab
+size_t inUse;       //bytes handed out
+size_t reserved;    //bytes held in slabs
+FreeBlock* freeLists[SIZECLASSES]; //free blocks, indexed by size / ALIGN
+
+//-----------------------------  roundUp  ---------------------------------
+// rounds a size up to a multiple of ALIGN, at least ALIGN
+// Preconditions:   none
+// Postconditions:  none
+static size_t roundUp(size_t);
+
+//-----------------------------  addSlab  ---------------------------------
+// allocates a slab with room for at least the number of bytes passed and
+// links it into the chain
+// Preconditions:   none
+// Postconditions:  returns the first usable byte of the new slab
+char* addSlab(size_t);
+
+};
+
+#endif
@@ -0,0 +1,436 @@
+//-----------------------------------------------------------------------//
+// BENCHMARK.CPP                                                         //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// Times every BinTree operation over several kinds of input and sizes,  //
+// and prints the results as CSV                                         //
+//-----------------------------------------------------------------------//
+// Usage:  benchmark [largest size]                                      //
+//       Sizes run from 1000 up to the largest size (default 1000000,    //
+//       at most 10000000) by factors of 10.                             //
+//                                                                       //
+// Output:  one header line, then one line per measurement:              //
+//       operation,distribution,balance,size,operations,seconds,ns_per_op//
+//       seconds is the best of several repetitions, so that small sizes //
+//       are not lost in timer noise; ns_per_op divides it by operations.//
+//                                                                       //
+// Distributions (of the size keys fed to the tree):                     //
+//   -- sorted, reverse:  distinct keys in increasing, decreasing order  //
+//   -- random:  distinct keys in a fixed pseudo-random order            //
+//   -- zipf:  keys drawn with Zipf's law (s = 1) from size candidates,  //
+//      so a few keys repeat very often                                  //
+//   -- duplicates:  keys drawn uniformly from size / 100 candidates     //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- every balancing policy is measured; an UNBALANCED or SPLAY tree  //
+//      fed sorted or reverse keys may be a linked list, quadratic to    //
+//      build and as deep as it is long, so those runs stop at           //
+//      UNBALANCEDSORTED keys.  AVL and WEIGHTED trees bound their depth //
+//      on insert, so they run sorted and reverse keys at every size     //
+//   -- retrieve is timed through a non-const tree, so SPLAY trees splay //
+//      and WEIGHTED trees reweigh as they would in use                  //
+//   -- retrieveAbsent looks up keys that fall between the tree's, and   //
+//      retrieveAbsentFiltered the same keys in a copy with a Bloom      //
+//      filter at FILTERRATE                                             //
+//   -- insert allocates a NodeData per key and deletes the duplicates;  //
+//      findOrInsert builds the same tree copying only the new keys      //
+//   -- remove and removeLazy empty a copy of the tree key by key in the //
+//      input order, removeLazy leaving tombstones up to LAZYSHARE;      //
+//      removeRange empties it RANGEKEYS keys at a time                  //
+//   -- the input is a fixed function of the size, so runs of different  //
+//      builds can be compared line by line                              //
+//-----------------------------------------------------------------------//
+
+#include "bintree.h"
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+using namespace std;
+
+const int SMALLEST = 1000;               //first size measured
+const int LARGEST = 10000000;            //largest size allowed
+const int UNBALANCEDSORTED = 1000;       //largest degenerate tree built
+const long long WORK = 1000000;          //keys handled per measurement,
+										 //repetitions included
+const double BUDGET = 0.25;              //seconds to stop repeating after
+const double FILTERRATE = 0.01;          //false positive rate of filters
+const double LAZYSHARE = 0.25;           //tombstones' share that compacts
+const int RANGEKEYS = 100;               //keys each removeRange takes
+
+enum Distribution {SORTED, REVERSE, RANDOM, ZIPF, DUPLICATES};
+const char* const DISTRIBUTIONS[] = {"sorted", "reverse", "random", "zipf",
+									 "duplicates"};
+const int DISTRIBUTIONCOUNT = 5;
+
+const BinTree::Balance BALANCES[] = {BinTree::AVL, BinTree::UNBALANCED,
+									 BinTree::SPLAY, BinTree::WEIGHTED};
+const char* const BALANCENAMES[] = {"UNBALANCED", "AVL", "SPLAY",
+									"WEIGHTED"}; //indexed by Balance
+const int BALANCECOUNT = 4;
+
+//global function prototypes
+vector<string> makeKeys(Distribution, int);
+string keyFor(int);
+unsigned long long nextRandom(unsigned long long&);
+void buildTree(BinTree&, const vector<string>&);
+void benchmark(Distribution, BinTree::Balance, const vector<string>&);
+void report(const char*, Distribution, BinTree::Balance, int, long long,
+			double);
+
+//------------------------------ Stopwatch --------------------------------
+// accumulates the time spent between start and stop, so a measurement
+// can leave its setup untimed
+struct Stopwatch {
+	chrono::steady_clock::time_point started;
+	double seconds;
+
+	Stopwatch() : seconds(0) {
+	}
+	void start() {
+		started = chrono::steady_clock::now();
+	}
+	void stop() {
+		seconds += chrono::duration<double>(chrono::steady_clock::now() -
+											started).count();
+	}
+};
+
+//------------------------------ measure ----------------------------------
+// runs a measurement enough times to handle WORK keys in all, at least
+// once and for at most BUDGET seconds, and returns the best time; the
+// measurement is passed a Stopwatch to start and stop around the part
+// being timed
+// Preconditions:   the int is the number of keys one run handles
+// Postconditions:  none
+template <class Run>
+double measure(int keys, Run run) {
+	long long repetitions = max(1LL, WORK / max(keys, 1));
+	double best = -1;
+	Stopwatch total; //setup included
+	total.start();
+	for (long long i = 0; i < repetitions && total.seconds < BUDGET; i++) {
+		Stopwatch watch;
+		run(watch);
+		if (best < 0 || watch.seconds < best)
+			best = watch.seconds;
+		total.stop();
+		total.start();
+	}
+	return best;
+}
+
+//-------------------------------- main -----------------------------------
+// parses the largest size and runs every distribution, balance and size
+// up to it
+int main(int argc, char* argv[]) {
+	int largest = 1000000;
+	if (argc > 1)
+		largest = atoi(argv[1]);
+	if (argc > 2 || largest < SMALLEST || largest > LARGEST) {
+		cerr << "usage: " << argv[0] << " [largest size, " << SMALLEST
+			 << " to " << LARGEST << "]" << endl;
+		return 1;
+	}
+	cout << "operation,distribution,balance,size,operations,seconds,"
+		 << "ns_per_op" << endl;
+	for (int size = SMALLEST; size <= largest; size *= 10) {
+		for (int d = 0; d < DISTRIBUTIONCOUNT; d++) {
+			Distribution distribution = (Distribution)d;
+			vector<string> keys = makeKeys(distribution, size);
+			for (int b = 0; b < BALANCECOUNT; b++)
+				if (BALANCES[b] == BinTree::AVL ||
+					BALANCES[b] == BinTree::WEIGHTED ||
+					(distribution != SORTED && distribution != REVERSE) ||
+					size <= UNBALANCEDSORTED)
+					benchmark(distribution, BALANCES[b], keys);
+		}
+	}
+	return 0;
+}
+
+//------------------------------ makeKeys ---------------------------------
+// returns the keys of a distribution, as many as the size
+// Preconditions:   the size is positive
+// Postconditions:  none
+vector<string> makeKeys(Distribution distribution, int size) {
+	vector<string> keys;
+	keys.reserve(size);
+	unsigned long long state = (unsigned long long)size * 2654435761ULL;
+	if (distribution == SORTED || distribution == REVERSE ||
+		distribution == RANDOM) {
+		for (int i = 0; i < size; i++)
+			keys.push_back(keyFor(i));
+		if (distribution == REVERSE)
+			reverse(keys.begin(), keys.end());
+		if (distribution == RANDOM) //Fisher-Yates
+			for (int i = size - 1; i > 0; i--)
+				swap(keys[i], keys[nextRandom(state) % (i + 1)]);
+	} else if (distribution == ZIPF) {
+		vector<double> cumulative(size); //P(rank <= r), rank r has 1/r
+		double total = 0;
+		for (int r = 0; r < size; r++) {
+			total += 1.0 / (r + 1);
+			cumulative[r] = total;
+		}
+		for (int i = 0; i < size; i++) {
+			double draw = (nextRandom(state) >> 11) * 0x1.0p-53 * total;
+			int rank = lower_bound(cumulative.begin(), cumulative.end(),
+								   draw) - cumulative.begin();
+			keys.push_back(keyFor(min(rank, size - 1)));
+		}
+	} else {
+		int candidates = max(size / 100, 1);
+		for (int i = 0; i < size; i++)
+			keys.push_back(keyFor(nextRandom(state) % candidates));
+	}
+	return keys;
+}
+
+//------------------------------- keyFor ----------------------------------
+// returns the key for an int; keys sort as their ints do, and share a
+// short prefix as real keys often do
+// Preconditions:   the int is not negative
+// Postconditions:  none
+string keyFor(int index) {
+	char key[16];
+	snprintf(key, sizeof(key), "key%08d", index);
+	return key;
+}
+
+//----------------------------- nextRandom --------------------------------
+// advances a splitmix64 state and returns its next value
+// Preconditions:   none
+// Postconditions:  none
+unsigned long long nextRandom(unsigned long long& state) {
+	unsigned long long mixed = (state += 0x9e3779b97f4a7c15ULL);
+	mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebULL;
+	return mixed ^ (mixed >> 31);
+}
+
+//------------------------------ buildTree --------------------------------
+// inserts the keys into the tree in order, dropping the duplicates
+// Preconditions:   none
+// Postconditions:  the tree holds every distinct key
+void buildTree(BinTree& tree, const vector<string>& keys) {
+	for (size_t i = 0; i < keys.size(); i++) {
+		NodeData* key = new NodeData(keys[i]);
+		if (!tree.insert(key))
+			delete key;
+	}
+}
+
+//------------------------------ benchmark --------------------------------
+// times every operation for one distribution, balance and size, and
+// reports each
+// Preconditions:   none
+// Postconditions:  none
+void benchmark(Distribution distribution, BinTree::Balance balance,
+			   const vector<string>& keys) {
+	int size = (int)keys.size();
+	vector<NodeData> probes(keys.begin(), keys.end());
+	vector<NodeData> absent; //keys between the tree's, so misses search
+	absent.reserve(size);    //all the way down
+	for (int i = 0; i < size; i++)
+		absent.push_back(NodeData(keys[i] + "~"));
+	BinTree tree(balance);
+	buildTree(tree, keys);
+	int distinct = tree.size();
+	string text; //the keys as operator>> reads them
+	for (int i = 0; i < size; i++)
+		text += keys[i] + (i % 16 == 15 ? "\n" : " ");
+	text += "$$\n";
+	long long sink = 0; //keeps the results alive
+
+	report("insert", distribution, balance, size, size,
+		   measure(size, [&](Stopwatch& watch) {
+		BinTree built(balance);
+		watch.start();
+		buildTree(built, keys);
+		watch.stop();
+	}));
+
+	report("findOrInsert", distribution, balance, size, size,
+		   measure(size, [&](Stopwatch& watch) {
+		BinTree built(balance);
+		NodeData* found;
+		watch.start();
+		for (int i = 0; i < size; i++)
+			sink += built.findOrInsert(probes[i], found);
+		watch.stop();
+	}));
+
+	report("retrieve", distribution, balance, size, size,
+		   measure(size, [&](Stopwatch& watch) {
+		NodeData* found;
+		watch.start();
+		for (int i = 0; i < size; i++)
+			sink += tree.retrieve(probes[i], found);
+		watch.stop();
+	}));
+
+	report("retrieveAbsent", distribution, balance, size, size,
+		   measure(size, [&](Stopwatch& watch) {
+		NodeData* found;
+		watch.start();
+		for (int i = 0; i < size; i++)
+			sink += tree.retrieve(absent[i], found);
+		watch.stop();
+	}));
+
+	BinTree filtered(tree);
+	filtered.enableFilter(FILTERRATE);
+	report("retrieveAbsentFiltered", distribution, balance, size, size,
+		   measure(size, [&](Stopwatch& watch) {
+		NodeData* found;
+		watch.start();
+		for (int i = 0; i < size; i++)
+			sink += filtered.retrieve(absent[i], found);
+		watch.stop();
+	}));
+
+	report("getDepth", distribution, balance, size, size,
+		   measure(size, [&](Stopwatch& watch) {
+		watch.start();
+		for (int i = 0; i < size; i++)
+			sink += tree.getDepth(probes[i]);
+		watch.stop();
+	}));
+
+	report("copy", distribution, balance, size, distinct,
+		   measure(distinct, [&](Stopwatch& watch) {
+		watch.start();
+		BinTree copy(tree);
+		watch.stop();
+		sink += copy.size();
+	}));
+
+	report("assign", distribution, balance, size, distinct,
+		   measure(distinct, [&](Stopwatch& watch) {
+		BinTree copy(balance);
+		buildTree(copy, vector<string>(keys.begin(),
+									   keys.begin() + size / 2));
+		watch.start();
+		copy = tree;
+		watch.stop();
+		sink += copy.size();
+	}));
+
+	report("equal", distribution, balance, size, distinct,
+		   measure(distinct, [&](Stopwatch& watch) {
+		BinTree copy(tree);
+		watch.start();
+		sink += copy == tree;
+		watch.stop();
+	}));
+
+	report("bstreeToArray", distribution, balance, size, distinct,
+		   measure(distinct, [&](Stopwatch& watch) {
+		BinTree copy(tree);
+		vector<NodeData*> array(distinct + 1, (NodeData*)NULL);
+		watch.start();
+		copy.bstreeToArray(&array[0]);
+		watch.stop();
+		copy.arrayToBSTree(&array[0], distinct);
+	}));
+
+	report("arrayToBSTree", distribution, balance, size, distinct,
+		   measure(distinct, [&](Stopwatch& watch) {
+		BinTree copy(tree);
+		vector<NodeData*> array(distinct + 1, (NodeData*)NULL);
+		copy.bstreeToArray(&array[0]);
+		watch.start();
+		copy.arrayToBSTree(&array[0], distinct);
+		watch.stop();
+	}));
+
+	report("output", distribution, balance, size, distinct,
+		   measure(distinct, [&](Stopwatch& watch) {
+		ofstream discard("/dev/null");
+		watch.start();
+		discard << tree;
+		watch.stop();
+	}));
+
+	report("input", distribution, balance, size, size,
+		   measure(size, [&](Stopwatch& watch) {
+		BinTree read(balance);
+		istringstream in(text);
+		watch.start();
+		in >> read;
+		watch.stop();
+	}));
+
+	report("ingest", distribution, balance, size, size,
+		   measure(size, [&](Stopwatch& watch) {
+		BinTree read(balance);
+		istringstream in(text);
+		watch.start();
+		Tokenizer source(in);
+		read.ingest(source);
+		watch.stop();
+	}));
+
+	report("remove", distribution, balance, size, size,
+		   measure(size, [&](Stopwatch& watch) {
+		BinTree copy(tree);
+		watch.start();
+		for (int i = 0; i < size; i++)
+			sink += copy.remove(probes[i]);
+		watch.stop();
+	}));
+
+	report("removeLazy", distribution, balance, size, size,
+		   measure(size, [&](Stopwatch& watch) {
+		BinTree copy(tree);
+		copy.enableLazyRemove(LAZYSHARE);
+		watch.start();
+		for (int i = 0; i < size; i++)
+			sink += copy.remove(probes[i]);
+		watch.stop();
+	}));
+
+	vector<NodeData*> sorted; //range ends, still owned by tree
+	tree.exportInorder(sorted);
+	report("removeRange", distribution, balance, size, distinct,
+		   measure(distinct, [&](Stopwatch& watch) {
+		BinTree copy(tree);
+		watch.start();
+		for (int i = 0; i < distinct; i += RANGEKEYS) {
+			int last = i + RANGEKEYS < distinct ? i + RANGEKEYS : distinct;
+			sink += copy.removeRange(*sorted[i], *sorted[last - 1]);
+		}
+		watch.stop();
+	}));
+
+	report("teardown", distribution, balance, size, distinct,
+		   measure(distinct, [&](Stopwatch& watch) {
+		BinTree copy(tree);
+		watch.start();
+		copy.makeEmpty();
+		watch.stop();
+	}));
+
+	if (sink == -1) //never true; stops the loops being optimized away
+		cerr << sink << endl;
+}
+
+//------------------------------- report ----------------------------------
+// prints one CSV line
+// Preconditions:   none
+// Postconditions:  none
+void report(const char* operation, Distribution distribution,
+			BinTree::Balance balance, int size, long long operations,
+			double seconds) {
+	char line[256];
+	snprintf(line, sizeof(line), "%s,%s,%s,%d,%lld,%.9f,%.2f", operation,
+			 DISTRIBUTIONS[distribution], BALANCENAMES[balance], size,
+			 operations, seconds,
+			 operations > 0 ? seconds * 1e9 / operations : 0.0);
+	cout << line << endl;
+}
@@ -11,10 +11,26 @@
 //				 child is larger in value.                                   //
 //                                                                       //
 // Implementation and assumptions:                                       //
-// TODO                    															 //
+//   -- A tree built with BinTree(BinTree::AVL) rebalances on every      //
+//      insert, keeping the height within 1.44 log2(n)                   //
+//   -- Nodes, and the NodeDatas the tree copies itself, come from an    //
+//      Arena; makeEmpty frees the tree's own Arena a slab at a time     //
+//   -- enableHashing makes every Node keep a hash of its subtree's      //
+//      contents, the sum of its keys' mixed hashes, so it does not      //
+//      depend on shape and is kept up on every write for a few adds     //
+//   -- a tree built with BinTree::COPY_ON_WRITE shares its Nodes with   //
+//      its copies; a write copies the shared Nodes on its path first,   //
+//      so a copy costs O(1).  Trees sharing Nodes share one Arena too,  //
+//      locked around each allocation                                    //
+//   -- walks forked onto a TaskPool hand each task an Arena, buffer or  //
+//      result of its own, merged after the join                         //
 //-----------------------------------------------------------------------//
 
 #include "bintree.h"
+#include "mappedtree.h"
+#include <new>
+#include <thread>
+#include <utility>
 
 //-------------------------- Constructor ----------------------------------
 // Default constructor for class BinTree
@@ -23,31 +39,169 @@
 //       -- a tree of size 0 is created  
 BinTree::BinTree() {
 	root = NULL;
+	balance = UNBALANCED;
+	arena = new Arena;
+	ownsArena = true;
+	share = NULL;
+	hashing = false;
+	counting = false;
+	removeRatio = 0;
+	tombstones = 0;
+	pool = NULL;
+	counters = NULL;
+	sinceReweigh = 0;
+	filter = NULL;
+}
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the balancing policy of the tree
+// Preconditions:   none
+// Postconditions:  
+//       -- a tree of size 0 is created, balanced according to the policy
+BinTree::BinTree(Balance policy) {
+	root = NULL;
+	balance = policy;
+	arena = new Arena;
+	ownsArena = true;
+	share = NULL;
+	hashing = false;
+	counting = false;
+	removeRatio = 0;
+	tombstones = 0;
+	pool = NULL;
+	counters = NULL;
+	sinceReweigh = 0;
+	filter = NULL;
+}
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the balancing policy and an Arena owned by the
+// caller, which may be shared by several trees
+// Preconditions:   the Arena outlives this tree
+// Postconditions:  
+//       -- a tree of size 0 is created; its Nodes come from the Arena
+BinTree::BinTree(Balance policy, Arena& shared) {
+	root = NULL;
+	balance = policy;
+	arena = &shared;
+	ownsArena = false;
+	share = NULL;
+	hashing = false;
+	counting = false;
+	removeRatio = 0;
+	tombstones = 0;
+	pool = NULL;
+	counters = NULL;
+	sinceReweigh = 0;
+	filter = NULL;
+}
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the balancing policy and what copies of the tree
+// do; a tree that copies on write starts a Share of its own
+// Preconditions:   none
+// Postconditions:
+//       -- a tree of size 0 is created
+BinTree::BinTree(Balance policy, Copying copying) {
+	root = NULL;
+	balance = policy;
+	share = NULL;
+	hashing = false;
+	counting = false;
+	removeRatio = 0;
+	tombstones = 0;
+	pool = NULL;
+	counters = NULL;
+	sinceReweigh = 0;
+	filter = NULL;
+	if (copying == COPY_ON_WRITE) {
+		Share* fresh = new Share;
+		fresh->trees = 0;
+		joinShare(fresh);
+	} else {
+		arena = new Arena;
+		ownsArena = true;
+	}
+}
+
+//------------------------- Bulk Constructor ------------------------------
+// Constructor accepting a batch of strings to bulk load, and the policy
+// Preconditions:   bulkLoad works
+// Postconditions:
+//       -- the tree holds one NodeData per distinct string, and is
+//          balanced as arrayToBSTree would build it
+BinTree::BinTree(const vector<string>& batch, Balance policy) {
+	root = NULL;
+	balance = policy;
+	arena = new Arena;
+	ownsArena = true;
+	share = NULL;
+	hashing = false;
+	counting = false;
+	removeRatio = 0;
+	tombstones = 0;
+	pool = NULL;
+	counters = NULL;
+	sinceReweigh = 0;
+	filter = NULL;
+	bulkLoad(batch);
 }
 
 //------------------------- Copy Constructor ------------------------------
-// Constructor accepting a BinTree to be deep copied 
+// Constructor accepting a BinTree to be deep copied; a tree that copies
+// on write is copied in O(1) by sharing its root instead
 // Preconditions:  none
 // Postconditions:
 //       -- a BinTree an exact copy of the parameter is made
 BinTree::BinTree(const BinTree& toCopy) {
 	root = NULL;
-	copyTree(root, toCopy.root);
+	balance = toCopy.balance;
+	share = NULL;
+	hashing = toCopy.hashing;
+	counting = toCopy.counting;
+	removeRatio = toCopy.removeRatio;
+	tombstones = toCopy.tombstones;
+	pool = toCopy.pool;
+	counters = NULL; //a copy starts uncounted
+	sinceReweigh = 0;
+	filter = toCopy.filter != NULL ? new BloomFilter(*toCopy.filter) : NULL;
+	if (toCopy.share != NULL) {
+		joinShare(toCopy.share);
+		root = toCopy.root;
+		if (root != NULL)
+			root->refs++;
+	} else {
+		arena = new Arena;
+		ownsArena = true;
+		root = copyTree(toCopy.root, *arena);
+	}
 }
 
-//-----------------------------  copyTree  --------------------------------
-// recursive helper function for copy constructor and assignment operator
-// Preconditions:   this tree is empty; root of tree to be copied is passed
-// Postconditions:  this tree is a deep copy of the root passed
-void BinTree::copyTree(Node*& cur, Node* other) {
-	if (other != NULL) {
-		cur = new Node;
-		cur->data = new NodeData(*other->data);
-		cur->left = NULL;
-		cur->right = NULL;
-		copyTree(cur->left, other->left);
-		copyTree(cur->right, other->right);
+//------------------------- Move Constructor ------------------------------
+// Constructor taking over the Nodes of a BinTree in O(1)
+// Preconditions:   swap works
+// Postconditions:
+//       -- this tree holds what the parameter held; the parameter is an
+//          empty tree with the same policies
+BinTree::BinTree(BinTree&& toMove) {
+	root = NULL;
+	balance = toMove.balance;
+	share = NULL;
+	hashing = false;
+	counting = false;
+	removeRatio = 0;
+	tombstones = 0;
+	pool = NULL;
+	counters = NULL;
+	sinceReweigh = 0;
+	filter = NULL;
+	if (toMove.share != NULL)
+		joinShare(toMove.share);
+	else {
+		arena = new Arena;
+		ownsArena = true;
 	}
+	swap(toMove);
 }
 
 //--------------------------- Destructor ----------------------------------
@@ -58,6 +212,36 @@ void BinTree::copyTree(Node*& cur, Node* other) {
 //		 -- root = NULL
 BinTree::~BinTree() {
 	makeEmpty();
+	detach();
+	delete counters;
+	delete filter;
+}
+
+//-----------------------------  joinShare  -------------------------------
+// makes this tree allocate from, and share Nodes with, the trees of a
+// Share
+// Preconditions:   this tree is empty and detached
+// Postconditions:  none
+void BinTree::joinShare(Share* joined) {
+	share = joined;
+	share->trees++;
+	arena = &share->arena;
+	ownsArena = false;
+}
+
+//------------------------------  detach  ---------------------------------
+// lets go of this tree's Arena, deleting it if no other tree uses it
+// Preconditions:   this tree is empty
+// Postconditions:  arena and share are NULL
+void BinTree::detach() {
+	if (share != NULL) {
+		if (share->trees.fetch_sub(1) == 1) //last tree using it
+			delete share;
+	} else if (ownsArena)
+		delete arena;
+	share = NULL;
+	arena = NULL;
+	ownsArena = false;
 }
 
 //----------------------------- isEmpty -----------------------------------
@@ -66,7 +250,7 @@ BinTree::~BinTree() {
 // Postconditions:  Returns true if there are no Nodes in BinTree, returns
 //					false if otherwise
 bool BinTree::isEmpty() const {
-	return root == NULL;
+	return sizeOf(root) == 0; //tombstones may be all that is left
 }
 
 //---------------------------- makeEmpty ----------------------------------
@@ -75,25 +259,56 @@ bool BinTree::isEmpty() const {
 // Postconditions:  
 //       -- no Nodes in BinTree, root = NULL
 void BinTree::makeEmpty() {
-	makeEmptyHelper(root);
+	makeEmptyHelper(root, ownsArena);
 	root = NULL;
+	sinceReweigh = 0;
+	tombstones = 0;
+	if (filter != NULL)
+		filter->clear();
+	if (ownsArena) //every block in it belonged to this tree
+		arena->release();
 }
 
 //---------------------------  makeEmptyHelper  ---------------------------
-// recursive helper function for the destructor and makeEmpty function
-// Preconditions:   root of this tree is passed
+// recursive helper function for the destructor and makeEmpty function;
+// Nodes are only handed back one at a time when the arena is shared.  A
+// released arena takes the memory of its NodeDatas back with it, so they
+// are only destroyed; with no arena calls left, or with every one locked
+// for a shared arena, large subtrees are emptied by forkEmptyHelper
+// Preconditions:   root of this tree is passed; the bool says the arena
+//			is released afterwards
 // Postconditions:  tree is empty of all nodes
-void BinTree::makeEmptyHelper(Node* cur) {
+void BinTree::makeEmptyHelper(Node* cur, bool releasing) const {
 	if (cur != NULL) {
-		makeEmptyHelper(cur->left);
-		makeEmptyHelper(cur->right);
-		delete cur->data;
-		cur->data = NULL;
-		delete cur;
+		if (share != NULL && cur->refs.fetch_sub(1) > 1)
+			return; //another tree still holds this subtree
+		if ((releasing || share != NULL) && parallelWalk(cur))
+			forkEmptyHelper(cur, releasing);
+		else {
+			makeEmptyHelper(cur->left, releasing);
+			makeEmptyHelper(cur->right, releasing);
+		}
+		if (releasing && cur->ownsData)
+			cur->data->~NodeData();
+		else
+			destroyData(cur);
+		if (!releasing)
+			freeNode(cur);
 		cur = NULL;
 	}
 }
 
+//--------------------------  forkEmptyHelper  ----------------------------
+// helper for makeEmptyHelper; empties the two subtrees of a Node on the
+// pool.  Kept apart, as the other fork helpers are, so that what a fork
+// needs does not weigh on every level of a deep serial walk
+// Preconditions:   as makeEmptyHelper
+// Postconditions:  the Node's subtrees are empty of all nodes
+void BinTree::forkEmptyHelper(Node* cur, bool releasing) const {
+	forkJoin([&]() { makeEmptyHelper(cur->left, releasing); },
+			 [&]() { makeEmptyHelper(cur->right, releasing); });
+}
+
 //------------------------------ insert -----------------------------------
 // Add a NodeData to BinTree, returns true if successful
 // Preconditions:   insertHelper
@@ -101,42 +316,719 @@ void BinTree::makeEmptyHelper(Node* cur) {
 //       -- the NodeData is pointed to by a new Node which is correctly 
 //			placed in BinTree
 bool BinTree::insert(NodeData* newNodeData) {
-	if (root == NULL) { //empty tree
-		root = new Node;
-		root->data = &*newNodeData;
-		root->left = NULL;
-		root->right = NULL;
+	NodeData* found;
+	return insertKey(newNodeData, *newNodeData, found);
+}
+
+//---------------------------- findOrInsert -------------------------------
+// Finds the NodeData equal to the parameter, inserting a copy made in the
+// arena only if there is none; a counting tree counts the key again
+// Preconditions:   none
+// Postconditions:  returns true if the copy was inserted; the second
+//			parameter points to the tree's NodeData for the key either way
+bool BinTree::findOrInsert(const NodeData& key, NodeData*& found) {
+	return insertKey(NULL, key, found);
+}
+
+//----------------------------  insertCopy  -------------------------------
+// inserts a copy of the NodeData passed, made in the arena only if it is
+// not already in the tree
+// Preconditions:   none
+// Postconditions:  returns true if the copy was inserted
+bool BinTree::insertCopy(const NodeData& key) {
+	NodeData* found;
+	return insertKey(NULL, key, found);
+}
+
+//-----------------------------  insertKey  -------------------------------
+// inserts the NodeData passed, or a copy of the key made in the arena if
+// it is NULL, unless the key is already in the tree; then a counting
+// tree adds one to the key's count instead
+// Preconditions:   a NodeData passed is the key
+// Postconditions:  returns true if inserted; found points to the tree's
+//			NodeData for the key either way
+bool BinTree::insertKey(NodeData* newNodeData, const NodeData& key,
+						NodeData*& found) {
+	if (share != NULL && balance != SPLAY && !counting &&
+		retrieve(key, found))
+		return false; //a duplicate must not copy the path it searched
+	reweighIfDue();
+	Probe probe = makeProbe(key);
+	bool inserted = balance == SPLAY ? splayInsert(newNodeData, probe) :
+					insertHelper(newNodeData, probe, root);
+	if (probe.deep) //tombstones hid every scapegoat from the sizes
+		reweigh();
+	found = probe.match->data;
+	if (inserted && filter != NULL)
+		addToFilter(key);
+	else if (!inserted && counting)
+		probe.match->count++; //the search unshared it
+	if (counters != NULL)
+		countSearch(probe, counters->inserts, counters->insertComparisons);
+	return inserted;
+}
+
+//-------------------------------- count ----------------------------------
+// Returns how many times a key was inserted into a counting tree, or 1
+// if it is in a tree that does not count; 0 if it is not in the tree
+// Preconditions:   none
+// Postconditions:  none
+int BinTree::count(const NodeData& toFind) const {
+	if (filteredOut(toFind))
+		return 0;
+	Probe probe = makeProbe(toFind);
+	Node* found = findNode(probe);
+	return found != NULL && !found->dead ? found->count : 0;
+}
+
+//------------------------------  findNode  -------------------------------
+// returns the Node holding the Probe's key, or NULL; a loop, so it can
+// follow the path of any tree
+// Preconditions:   none
+// Postconditions:  none
+BinTree::Node* BinTree::findNode(Probe& probe) const {
+	Node* cur = root;
+	while (cur != NULL) {
+		int order = compareProbe(probe, cur);
+		if (order == 0)
+			return cur;
+		cur = order < 0 ? cur->left : cur->right;
+	}
+	return NULL;
+}
+
+//--------------------------- enableCounting ------------------------------
+// Makes the tree a multiset: inserting a key it holds adds one to the
+// key's count instead of being dropped
+// Preconditions:   none
+// Postconditions:  isCounting() is true, and stays true for copies
+void BinTree::enableCounting() {
+	counting = true;
+}
+
+//--------------------------- disableCounting -----------------------------
+// Drops duplicates again; the counts so far are kept
+// Preconditions:   none
+// Postconditions:  isCounting() is false
+void BinTree::disableCounting() {
+	counting = false;
+}
+
+//----------------------------- isCounting --------------------------------
+// Returns true if inserting a key the tree holds counts it
+// Preconditions:   none
+// Postconditions:  none
+bool BinTree::isCounting() const {
+	return counting;
+}
+
+//------------------------------- remove ----------------------------------
+// Removes the NodeData equal to the parameter, returns true if it was in
+// the tree.  Eagerly, the Node is unlinked and freed, its in order
+// successor taking its place if it has two children, and the path is
+// rebalanced on the way back up as insert does.  Removing lazily only
+// marks the Node a tombstone and fixes the sizes on its path, and the
+// tree is compacted once the tombstones pass their share
+// Preconditions:   none
+// Postconditions:  the key is no longer in the tree
+bool BinTree::remove(const NodeData& toRemove) {
+	Probe probe = makeProbe(toRemove);
+	if (share != NULL) { //an absent key must not copy the path it searched
+		Node* found = findNode(probe);
+		if (found == NULL || found->dead)
+			return false;
+		probe = makeProbe(toRemove);
+	}
+	if (removeRatio == 0)
+		return removeHelper(probe, root);
+	if (!buryHelper(probe, root))
+		return false;
+	tombstones++;
+	compactIfDue();
+	return true;
+}
+
+//----------------------------- removeRange -------------------------------
+// Removes every NodeData from the first parameter to the second, both
+// included, returns how many there were.  Eagerly, the tree is split
+// around the two keys and the outer parts joined, O(log n) besides
+// freeing the Nodes removed, and a tree sharing its Nodes copies only
+// those split and join relink; lazily, the Nodes in the range are
+// marked, O(log n) plus one step per key marked
+// Preconditions:   none
+// Postconditions:  no key in the range is in the tree
+int BinTree::removeRange(const NodeData& low, const NodeData& high) {
+	if (root == NULL || high < low)
+		return 0;
+	if (removeRatio > 0) {
+		int buried = buryRange(root, low, high);
+		tombstones += buried;
+		compactIfDue();
+		return buried;
+	}
+	int before = size();
+	Node *left, *first, *middle, *last, *right;
+	split(root, low, left, first, middle);
+	split(middle, high, middle, last, right);
+	makeEmptyHelper(first, false);
+	makeEmptyHelper(middle, false);
+	makeEmptyHelper(last, false);
+	root = joinTwo(left, right);
+	return before - size();
+}
+
+//--------------------------- enableLazyRemove ----------------------------
+// Makes remove and removeRange mark Nodes as tombstones instead of
+// unlinking them, and compact the tree, as compact does, once the
+// tombstones are more than the share passed of its Nodes.  A burst of
+// removals then costs one search each, and the rebuilds, linear in the
+// Nodes, are spread over many removals
+// Preconditions:   the share is in (0, 1)
+// Postconditions:  isRemovingLazily() is true, and stays true for copies
+void BinTree::enableLazyRemove(double ratio) {
+	removeRatio = ratio;
+	compactIfDue();
+}
+
+//--------------------------- disableLazyRemove ---------------------------
+// Compacts the tree, and removes eagerly from now on
+// Preconditions:   none
+// Postconditions:  isRemovingLazily() is false; there are no tombstones
+void BinTree::disableLazyRemove() {
+	compact();
+	removeRatio = 0;
+}
+
+//--------------------------- isRemovingLazily ----------------------------
+// Returns true if removing a key leaves a tombstone
+// Preconditions:   none
+// Postconditions:  none
+bool BinTree::isRemovingLazily() const {
+	return removeRatio > 0;
+}
+
+//------------------------------- compact ---------------------------------
+// Frees the tombstones: a WEIGHTED tree reweighs without them, any other
+// is rebuilt complete as rebalance builds it.  Nothing is done if there
+// are none
+// Preconditions:   none
+// Postconditions:  same NodeDatas; no tombstones
+void BinTree::compact() {
+	if (tombstones == 0)
+		return;
+	if (balance == WEIGHTED)
+		reweigh();
+	else
+		rebalance();
+}
+
+//----------------------------  compactIfDue  -----------------------------
+// compacts a tree that removes lazily once its tombstones are more than
+// their share of its Nodes
+// Preconditions:   none
+// Postconditions:  none
+void BinTree::compactIfDue() {
+	if (tombstones > removeRatio * (size() + tombstones))
+		compact();
+}
+
+//----------------------------  removeHelper  -----------------------------
+// recursive helper function for remove; unlinks and frees the Node
+// holding the Probe's key, rebalancing every subtree on the way back up
+// Preconditions:   root of this tree is passed as second parameter; the
+//			tree has no tombstones
+// Postconditions:  returns true if the key was found and removed
+bool BinTree::removeHelper(Probe& probe, Node*& cur) {
+	if (cur == NULL)
+		return false;
+	unshare(cur); //this Node is about to be written
+	int order = compareProbe(probe, cur);
+	if (order == 0) {
+		Node* gone = cur;
+		if (cur->left == NULL)
+			cur = cur->right;
+		else if (cur->right == NULL)
+			cur = cur->left;
+		else { //the successor takes the place of the Node removed
+			Node* next = removeFirst(gone->right);
+			next->left = gone->left;
+			next->right = gone->right;
+			cur = next;
+			restoreBalance(cur);
+		}
+		destroyData(gone);
+		freeNode(gone);
 		return true;
+	}
+	bool removed = order < 0 ? removeHelper(probe, cur->left) :
+				   removeHelper(probe, cur->right);
+	if (removed) //only the path just shortened can have changed shape
+		restoreBalance(cur);
+	return removed;
+}
+
+//-----------------------------  removeFirst  -----------------------------
+// recursive helper function for removeHelper; takes the Node with the
+// smallest key out of a subtree, rebalancing on the way back up
+// Preconditions:   the subtree is not empty; its parent, if any, is only
+//			held by this tree
+// Postconditions:  returns the Node taken out, only held by this tree
+BinTree::Node* BinTree::removeFirst(Node*& cur) {
+	unshare(cur);
+	if (cur->left == NULL) {
+		Node* first = cur;
+		cur = cur->right;
+		return first;
+	}
+	Node* first = removeFirst(cur->left);
+	restoreBalance(cur);
+	return first;
+}
+
+//-----------------------------  buryHelper  ------------------------------
+// recursive helper function for remove; marks the Node holding the
+// Probe's key a tombstone, fixing the sizes and hashes on the way back up
+// Preconditions:   root of this tree is passed as second parameter
+// Postconditions:  returns true if a live Node was marked
+bool BinTree::buryHelper(Probe& probe, Node*& cur) {
+	if (cur == NULL)
+		return false;
+	unshare(cur); //this Node is about to be written
+	int order = compareProbe(probe, cur);
+	bool buried;
+	if (order < 0)
+		buried = buryHelper(probe, cur->left);
+	else if (order > 0)
+		buried = buryHelper(probe, cur->right);
+	else {
+		buried = !cur->dead;
+		cur->dead = true;
+	}
+	if (buried)
+		updateNode(cur);
+	return buried;
+}
+
+//------------------------------  buryRange  ------------------------------
+// recursive helper function for removeRange; marks every live Node of a
+// subtree from the first key to the second a tombstone, only going down
+// the sides that can hold keys in the range
+// Preconditions:   the first key is not larger than the second
+// Postconditions:  returns the number of Nodes marked
+int BinTree::buryRange(Node*& cur, const NodeData& low,
+					   const NodeData& high) {
+	if (cur == NULL)
+		return 0;
+	unshare(cur);
+	int buried = 0;
+	bool aboveLow = low < *cur->data;
+	bool belowHigh = *cur->data < high;
+	if (aboveLow)
+		buried += buryRange(cur->left, low, high);
+	if (belowHigh)
+		buried += buryRange(cur->right, low, high);
+	if (!cur->dead && (aboveLow || low == *cur->data) &&
+		(belowHigh || high == *cur->data)) {
+		cur->dead = true;
+		buried++;
+	}
+	if (buried > 0)
+		updateNode(cur);
+	return buried;
+}
+
+//------------------------------  purgeVine  ------------------------------
+// unlinks the tombstones from a vine and frees them
+// Preconditions:   the pseudo root's right link holds the vine; no Node
+//			of it is held by another tree
+// Postconditions:  returns the number of Nodes freed; the tree has no
+//			tombstones
+int BinTree::purgeVine(Node* pseudoRoot) {
+	int purged = 0;
+	Node* tail = pseudoRoot;
+	while (tail->right != NULL) {
+		Node* cur = tail->right;
+		if (cur->dead) {
+			tail->right = cur->right;
+			destroyData(cur);
+			freeNode(cur);
+			purged++;
+		} else
+			tail = cur;
+	}
+	tombstones = 0;
+	return purged;
+}
+
+//-------------------------------  revive  --------------------------------
+// brings back the tombstone of a key being inserted again; a NodeData
+// passed replaces the one the tombstone kept
+// Preconditions:   the Node is a tombstone for the key, only held by
+//			this tree
+// Postconditions:  the Node is live, counted once; its size is not yet
+//			updated
+void BinTree::revive(Node* cur, NodeData* newNodeData) {
+	if (newNodeData != NULL) {
+		destroyData(cur);
+		cur->data = newNodeData;
+	}
+	cur->dead = false;
+	cur->count = 1;
+	cur->hits.store(0, memory_order_relaxed);
+	tombstones--;
+}
+
+//----------------------------  createNode  -------------------------------
+// allocates a leaf Node pointing to the NodeData passed
+// Preconditions:   none
+// Postconditions:  returns the new Node, with NULL children, height 1
+//			and size 1
+BinTree::Node* BinTree::createNode(NodeData* nodeData) const {
+	return initNode(allocate(sizeof(Node)), nodeData);
+}
+
+//-----------------------------  initNode  --------------------------------
+// makes a leaf Node pointing to the NodeData passed in the memory passed
+// Preconditions:   the memory holds sizeof(Node) bytes
+// Postconditions:  returns the new Node, with NULL children, height 1
+//			and size 1
+BinTree::Node* BinTree::initNode(void* memory, NodeData* nodeData) const {
+	Node* fresh = new (memory) Node;
+	fresh->data = &*nodeData;
+	fresh->left = NULL;
+	fresh->right = NULL;
+	fresh->height = 1;
+	fresh->size = 1;
+	fresh->ownsData = false;
+	fresh->dead = false;
+	fresh->hits.store(0, memory_order_relaxed);
+	fresh->count = 1;
+	fresh->refs.store(1, memory_order_relaxed); //not reachable yet
+	fresh->prefix = nodeData->keyPrefix();
+	fresh->keyHash = hashing ? mixHash(nodeData->hash()) : 0;
+	fresh->hash = fresh->keyHash;
+	return fresh;
+}
+
+//----------------------------  copyData  ---------------------------------
+// allocates a copy of the NodeData passed in the Arena passed, which
+// need not be this tree's
+// Preconditions:   none
+// Postconditions:  returns the copy; a Node pointing to it must have
+//			ownsData set
+NodeData* BinTree::copyData(const NodeData& toCopy, Arena& memory) {
+	return new (memory.allocate(sizeof(NodeData))) NodeData(toCopy);
+}
+
+//----------------------------  copyData  ---------------------------------
+// allocates a copy of the NodeData passed in the arena
+// Preconditions:   none
+// Postconditions:  returns the copy; a Node pointing to it must have
+//			ownsData set so destroyData gives it back to the arena
+NodeData* BinTree::copyData(const NodeData& toCopy) const {
+	return new (allocate(sizeof(NodeData))) NodeData(toCopy);
+}
+
+//----------------------------  copyData  ---------------------------------
+// allocates a NodeData holding the string passed in the arena
+// Preconditions:   none
+// Postconditions:  as above
+NodeData* BinTree::copyData(const string& key) const {
+	return new (allocate(sizeof(NodeData))) NodeData(key);
+}
+
+//---------------------------  destroyData  -------------------------------
+// destroys the NodeData of a Node, giving its memory back to wherever it
+// was allocated from
+// Preconditions:   none
+// Postconditions:  the Node's data is NULL
+void BinTree::destroyData(Node* cur) const {
+	if (cur->ownsData) {
+		cur->data->~NodeData();
+		deallocate(cur->data, sizeof(NodeData));
 	} else
-		return insertHelper(newNodeData, root, root, true);
+		delete cur->data;
+	cur->data = NULL;
+	cur->ownsData = false;
+}
+
+//----------------------------  freeNode  ---------------------------------
+// gives a Node's memory back to the arena
+// Preconditions:   the Node's data has been destroyed or handed off
+// Postconditions:  none
+void BinTree::freeNode(Node* cur) const {
+	cur->~Node();
+	deallocate(cur, sizeof(Node));
+}
+
+//-----------------------------  allocate  --------------------------------
+// allocates memory for a Node or NodeData from the arena, locking it if
+// other trees use it
+// Preconditions:   none
+// Postconditions:  returns the memory
+void* BinTree::allocate(size_t bytes) const {
+	if (counters != NULL)
+		counters->allocations.fetch_add(1, memory_order_relaxed);
+	if (share == NULL)
+		return arena->allocate(bytes);
+	lock_guard<mutex> hold(share->lock);
+	return arena->allocate(bytes);
+}
+
+//----------------------------  deallocate  -------------------------------
+// gives memory back to the arena, locking it if other trees use it
+// Preconditions:   the size is the one the memory was allocated with
+// Postconditions:  none
+void BinTree::deallocate(void* memory, size_t bytes) const {
+	if (counters != NULL)
+		counters->deallocations.fetch_add(1, memory_order_relaxed);
+	if (share == NULL) {
+		arena->deallocate(memory, bytes);
+		return;
+	}
+	lock_guard<mutex> hold(share->lock);
+	arena->deallocate(memory, bytes);
+}
+
+//-----------------------------  unshare  ---------------------------------
+// replaces a Node other trees also hold with a copy of it that only this
+// tree holds, sharing its children instead.  A Node held once is only
+// held by this tree, since its parent is
+// Preconditions:   the Node's parent, if any, is only held by this tree
+// Postconditions:  the Node passed back is only held by this tree
+void BinTree::unshare(Node*& cur) const {
+	if (share == NULL || cur->refs.load() == 1)
+		return;
+	Node* copy = createNode(copyData(*cur->data));
+	copy->ownsData = true;
+	copy->left = cur->left;
+	copy->right = cur->right;
+	copy->height = cur->height;
+	copy->size = cur->size;
+	copy->keyHash = cur->keyHash;
+	copy->hash = cur->hash;
+	copy->hits.store(cur->hits.load(memory_order_relaxed),
+					 memory_order_relaxed);
+	copy->count = cur->count;
+	copy->dead = cur->dead;
+	if (copy->left != NULL)
+		copy->left->refs++;
+	if (copy->right != NULL)
+		copy->right->refs++;
+	makeEmptyHelper(cur, false); //frees it if the other trees let go meanwhile
+	cur = copy;
+}
+
+//----------------------------  unshareAll  -------------------------------
+// recursive helper for writes that touch every Node; unshares a subtree
+// from the top down
+// Preconditions:   as unshare
+// Postconditions:  no Node of the subtree is held by another tree
+void BinTree::unshareAll(Node*& cur) {
+	if (cur != NULL && share != NULL) { //nothing is shared otherwise
+		unshare(cur);
+		unshareAll(cur->left);
+		unshareAll(cur->right);
+	}
 }
 
 //----------------------------  insertHelper  -----------------------------
 // recursive helper function for the insert function and returns true if
-// successful.  No duplicate NodeDatas are allowed
-// Preconditions:   root of this tree is passed as second and third 
-//			parameter
-// Postconditions:  NodeData is inserted into tree in correct place
-bool BinTree::insertHelper(NodeData* newNodeData, Node* cur,
-	                       Node* prev, bool left) {
-	if (cur != NULL) {
-		if (*newNodeData < *cur->data)
-			return insertHelper(newNodeData, cur->left, cur, true);
-		else if (*newNodeData > *cur->data)
-			return insertHelper(newNodeData, cur->right, cur, false);
-		else //newNodeData == cur->data
-			return false; //no duplicates
-	}  else {
-		cur = new Node;
-		cur->data = &*newNodeData;
-		cur->left = NULL;
-		cur->right = NULL;
-		if (left) //to check if this is prev's right or left child
-			prev->left = cur; 
-		else
-			prev->right = cur;
+// successful.  No duplicate NodeDatas are allowed.  A NULL NodeData*
+// inserts a copy of the Probe's key, made in the arena at the leaf
+// Preconditions:   root of this tree is passed as second parameter
+// Postconditions:  NodeData is inserted into tree in correct place, and
+//			every subtree on the way back up is rebalanced; the Probe's
+//			match is the Node holding the key, new or not
+bool BinTree::insertHelper(NodeData* newNodeData, Probe& probe,
+						   Node*& cur) {
+	if (cur == NULL) {
+		if (newNodeData != NULL)
+			cur = createNode(newNodeData);
+		else {
+			cur = createNode(copyData(*probe.key));
+			cur->ownsData = true;
+		}
+		probe.match = cur;
+		probe.deep = balance == WEIGHTED && tooDeep(probe.compares + 1);
 		return true;
 	}
+	unshare(cur); //this Node is about to be written
+	bool inserted;
+	int order = compareProbe(probe, cur);
+	if (order < 0)
+		inserted = insertHelper(newNodeData, probe, cur->left);
+	else if (order > 0)
+		inserted = insertHelper(newNodeData, probe, cur->right);
+	else if (!cur->dead) { //newNodeData == cur->data
+		probe.match = cur;
+		return false; //no duplicates
+	} else { //the key was removed lazily; its Node comes back instead
+		revive(cur, newNodeData);
+		probe.match = cur;
+		inserted = true;
+	}
+	if (inserted) //only the path just grown can have changed shape
+		restoreBalance(cur);
+	if (probe.deep && isScapegoat(cur)) { //the lowest one on the path
+		reweighSubtree(cur);
+		probe.deep = false;
+	}
+	return inserted;
+}
+
+//-----------------------------  makeProbe  -------------------------------
+// returns a Probe for a search from the root for the key passed; nothing
+// is known to be shared with the key yet
+// Preconditions:   none
+// Postconditions:  none
+BinTree::Probe BinTree::makeProbe(const NodeData& key) {
+	Probe probe;
+	probe.key = &key;
+	probe.prefix = key.keyPrefix();
+	probe.lowCommon = 0;
+	probe.highCommon = 0;
+	probe.compares = 0;
+	probe.match = NULL;
+	probe.deep = false;
+	return probe;
+}
+
+//---------------------------  compareProbe  ------------------------------
+// three way comparison of a Probe's key with a Node's.  Every key in the
+// Node's subtree lies between the last keys the search passed on either
+// side, so it shares at least the shorter of their common prefixes with
+// the Probe, and the string comparison starts after that.  A prefix
+// mismatch decides within the first 8 characters, so the side it leads
+// to is known to share nothing
+// Preconditions:   the Probe has been compared with every ancestor of the
+//			Node, in order from the root
+// Postconditions:  the Probe's common prefix lengths are updated for the
+//			child the result leads to
+int BinTree::compareProbe(Probe& probe, const Node* cur) {
+	probe.compares++;
+	if (probe.prefix != cur->prefix) {
+		if (probe.prefix < cur->prefix) {
+			probe.highCommon = 0;
+			return -1;
+		}
+		probe.lowCommon = 0;
+		return 1;
+	}
+	size_t common;
+	int order = probe.key->compare(*cur->data,
+			min(probe.lowCommon, probe.highCommon), common);
+	if (order < 0)
+		probe.highCommon = common;
+	else if (order > 0)
+		probe.lowCommon = common;
+	return order;
+}
+
+//-----------------------------  heightOf  --------------------------------
+// returns the height of the subtree passed, 0 for an empty subtree
+// Preconditions:   none
+// Postconditions:  none
+int BinTree::heightOf(Node* cur) {
+	return cur == NULL ? 0 : cur->height;
+}
+
+//------------------------------  sizeOf  ---------------------------------
+// returns the number of Nodes in the subtree passed
+// Preconditions:   none
+// Postconditions:  none
+int BinTree::sizeOf(Node* cur) {
+	return cur == NULL ? 0 : cur->size;
+}
+
+//----------------------------  updateNode  -------------------------------
+// recomputes the height, size and hash of a Node from those of its
+// children; sizes and hashes leave tombstones out
+// Preconditions:   the children's heights, sizes and hashes are correct
+// Postconditions:  the Node's height, size and hash are correct
+void BinTree::updateNode(Node* cur) {
+	cur->height = 1 + max(heightOf(cur->left), heightOf(cur->right));
+	cur->size = !cur->dead + sizeOf(cur->left) + sizeOf(cur->right);
+	cur->hash = (cur->dead ? 0 : cur->keyHash) + hashOf(cur->left) +
+				hashOf(cur->right);
+}
+
+//-------------------------------  hashOf  --------------------------------
+// returns the hash of the subtree passed, 0 for an empty subtree
+// Preconditions:   none
+// Postconditions:  none
+unsigned long long BinTree::hashOf(Node* cur) {
+	return cur == NULL ? 0 : cur->hash;
+}
+
+//------------------------------  mixHash  --------------------------------
+// scrambles a NodeData::hash so that sums of them rarely collide; the
+// splitmix64 finalizer, since std::hash may be the identity
+// Preconditions:   none
+// Postconditions:  none
+unsigned long long BinTree::mixHash(size_t keyHash) {
+	unsigned long long mixed = keyHash + 0x9e3779b97f4a7c15ULL;
+	mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebULL;
+	return mixed ^ (mixed >> 31);
+}
+
+//----------------------------  rotateLeft  -------------------------------
+// rotates the subtree left; its right child becomes the subtree's root
+// Preconditions:   the subtree has a right child
+// Postconditions:  in order sequence is unchanged, heights and sizes
+//			are correct
+void BinTree::rotateLeft(Node*& cur) {
+	Node* pivot = cur->right;
+	cur->right = pivot->left;
+	pivot->left = cur;
+	updateNode(cur);
+	updateNode(pivot);
+	cur = pivot;
+}
+
+//----------------------------  rotateRight  ------------------------------
+// rotates the subtree right; its left child becomes the subtree's root
+// Preconditions:   the subtree has a left child
+// Postconditions:  in order sequence is unchanged, heights and sizes
+//			are correct
+void BinTree::rotateRight(Node*& cur) {
+	Node* pivot = cur->left;
+	cur->left = pivot->right;
+	pivot->right = cur;
+	updateNode(cur);
+	updateNode(pivot);
+	cur = pivot;
+}
+
+//-------------------------  restoreBalance  ------------------------------
+// fixes the height and size of the subtree passed and, for an AVL tree,
+// performs the single or double rotation needed to restore the AVL
+// property.  After a removal the taller side is off the path that was
+// unshared, so the Nodes a rotation relinks are unshared first
+// Preconditions:   both children are valid subtrees under this policy;
+//			the Node passed is only held by this tree
+// Postconditions:  subtree is balanced under this tree's policy
+void BinTree::restoreBalance(Node*& cur) {
+	updateNode(cur);
+	if (balance != AVL)
+		return;
+	int skew = heightOf(cur->left) - heightOf(cur->right);
+	if (skew > 1) { //left heavy
+		unshare(cur->left);
+		if (heightOf(cur->left->left) < heightOf(cur->left->right)) {
+			unshare(cur->left->right);
+			rotateLeft(cur->left); //left-right case
+		}
+		rotateRight(cur);
+	} else if (skew < -1) { //right heavy
+		unshare(cur->right);
+		if (heightOf(cur->right->right) < heightOf(cur->right->left)) {
+			unshare(cur->right->left);
+			rotateRight(cur->right); //right-left case
+		}
+		rotateLeft(cur);
+	}
 }
 
 //---------------------------- retrieve -----------------------------------
@@ -147,28 +1039,314 @@ bool BinTree::insertHelper(NodeData* newNodeData, Node* cur,
 // Postconditions:  the second parameter points to the found object.  If 
 //			object is not found, no reassignment of ptr is made
 bool BinTree::retrieve(const NodeData& toFind, NodeData*& ptr) const {
-	return retrieveHelper(toFind, ptr, root);
+	Probe probe = makeProbe(toFind);
+	bool found = !filteredOut(toFind) && retrieveHelper(probe, ptr, root);
+	if (counters != NULL)
+		countSearch(probe, counters->retrieves,
+					counters->retrieveComparisons);
+	return found;
+}
+
+//---------------------------- retrieve -----------------------------------
+// Retrieve through a tree that may restructure itself: a SPLAY tree
+// splays the key found, or the last Node on its path, to the root, and a
+// WEIGHTED tree reweighs if it is due
+// Preconditions:   no other thread is using the tree
+// Postconditions:  as the const retrieve; in order sequence is unchanged
+bool BinTree::retrieve(const NodeData& toFind, NodeData*& ptr) {
+	if (balance != SPLAY) {
+		const BinTree& self = *this;
+		bool found = self.retrieve(toFind, ptr);
+		reweighIfDue();
+		return found;
+	}
+	Probe probe = makeProbe(toFind);
+	bool found = !filteredOut(toFind) && root != NULL &&
+				 splay(probe) == 0 && !root->dead;
+	if (found)
+		ptr = root->data;
+	if (counters != NULL)
+		countSearch(probe, counters->retrieves,
+					counters->retrieveComparisons);
+	return found;
+}
+
+//-------------------------------  splay  ---------------------------------
+// moves the Probe's key, or the last Node on its search path, to the
+// root, top down.  The search splits the tree as it goes into the Nodes
+// it passed on the right, hung along the left spine of a tree of larger
+// keys, and those passed on the left, hung along the right spine of a
+// tree of smaller keys; two steps the same way rotate first, which is
+// what halves the depth of the path.  Each spine link points back up the
+// spine until the end, so the spines can be relinked and updated bottom
+// up without a stack
+// Preconditions:   none
+// Postconditions:  returns the key's order against the root's, 0 if the
+//			root holds it; in order sequence, heights and sizes are correct
+int BinTree::splay(Probe& probe) {
+	if (root == NULL)
+		return 0;
+	Node* smaller = NULL; //deepest Node of the smaller keys' right spine
+	Node* larger = NULL;  //deepest Node of the larger keys' left spine
+	unshare(root);
+	Node* cur = root;
+	int order = compareProbe(probe, cur);
+	while (order != 0) {
+		if (order < 0) {
+			if (cur->left == NULL)
+				break;
+			unshare(cur->left);
+			int next = compareProbe(probe, cur->left);
+			if (next < 0) { //zig-zig
+				rotateRight(cur);
+				if (cur->left == NULL)
+					break;
+				unshare(cur->left);
+				next = compareProbe(probe, cur->left);
+			}
+			Node* below = cur->left; //hang cur on the larger keys
+			cur->left = larger;
+			larger = cur;
+			cur = below;
+			order = next;
+		} else {
+			if (cur->right == NULL)
+				break;
+			unshare(cur->right);
+			int next = compareProbe(probe, cur->right);
+			if (next > 0) { //zag-zag
+				rotateLeft(cur);
+				if (cur->right == NULL)
+					break;
+				unshare(cur->right);
+				next = compareProbe(probe, cur->right);
+			}
+			Node* below = cur->right; //hang cur on the smaller keys
+			cur->right = smaller;
+			smaller = cur;
+			cur = below;
+			order = next;
+		}
+	}
+	Node* subtree = cur->left; //relink the spines from the bottom up
+	while (smaller != NULL) {
+		Node* up = smaller->right;
+		smaller->right = subtree;
+		updateNode(smaller);
+		subtree = smaller;
+		smaller = up;
+	}
+	cur->left = subtree;
+	subtree = cur->right;
+	while (larger != NULL) {
+		Node* up = larger->left;
+		larger->left = subtree;
+		updateNode(larger);
+		subtree = larger;
+		larger = up;
+	}
+	cur->right = subtree;
+	updateNode(cur);
+	root = cur;
+	return order;
+}
+
+//-----------------------------  splayInsert  -----------------------------
+// insert for a SPLAY tree; splays the key to the root, or puts a new
+// Node for it above the Node splayed there, which the key splits from
+// the rest of its side
+// Preconditions:   the tree's policy is SPLAY
+// Postconditions:  returns true if inserted; the key is at the root
+bool BinTree::splayInsert(NodeData* newNodeData, Probe& probe) {
+	int order = splay(probe);
+	if (root != NULL && order == 0) {
+		probe.match = root;
+		if (!root->dead)
+			return false; //no duplicates
+		revive(root, newNodeData);
+		updateNode(root);
+		return true;
+	}
+	Node* fresh;
+	if (newNodeData != NULL)
+		fresh = createNode(newNodeData);
+	else {
+		fresh = createNode(copyData(*probe.key));
+		fresh->ownsData = true;
+	}
+	if (root != NULL) {
+		if (order < 0) {
+			fresh->left = root->left;
+			fresh->right = root;
+			root->left = NULL;
+		} else {
+			fresh->right = root->right;
+			fresh->left = root;
+			root->right = NULL;
+		}
+		updateNode(root);
+		updateNode(fresh);
+	}
+	root = fresh;
+	probe.match = fresh;
+	return true;
+}
+
+//------------------------------  noteHit  --------------------------------
+// counts a retrieve that found a Node of a WEIGHTED tree.  The counts
+// only rank keys by how hot they are, so they are loaded and stored
+// rather than locked: two threads counting at once may count one hit,
+// which costs far less than a locked add on every retrieve.  A Node's
+// count stops at MAXHITS
+// Preconditions:   none
+// Postconditions:  none
+void BinTree::noteHit(Node* cur) const {
+	unsigned short hits = cur->hits.load(memory_order_relaxed);
+	if (hits < MAXHITS)
+		cur->hits.store(hits + 1, memory_order_relaxed);
+	sinceReweigh.store(sinceReweigh.load(memory_order_relaxed) + 1,
+					   memory_order_relaxed);
+}
+
+//--------------------------  reweighIfDue  -------------------------------
+// reweighs a WEIGHTED tree once it has counted as many hits as it has
+// Nodes, so that the O(n log n) rebuild costs O(log n) per retrieve
+// Preconditions:   no other thread is using the tree
+// Postconditions:  none
+void BinTree::reweighIfDue() {
+	if (balance != WEIGHTED)
+		return;
+	long long due = size() > REWEIGHMIN ? size() : REWEIGHMIN;
+	if (sinceReweigh.load(memory_order_relaxed) >= due)
+		reweigh();
+}
+
+//------------------------------- reweigh ---------------------------------
+// Rebuilds the tree in place so that keys retrieved often sit near the
+// root.  The tree is first flattened into a sorted vine, as rebalance
+// does, and freed of its tombstones; each Node weighs one more than its
+// hits
+// Preconditions:   none
+// Postconditions:  same NodeDatas; hits are halved
+void BinTree::reweigh() {
+	unshareAll(root);
+	Node pseudoRoot; //its right link holds the vine
+	pseudoRoot.left = NULL;
+	pseudoRoot.right = root;
+	vector<Node*> nodes;
+	int count = treeToVine(&pseudoRoot);
+	nodes.reserve(count - purgeVine(&pseudoRoot));
+	vector<long long> totals(1, 0);
+	for (Node* cur = pseudoRoot.right; cur != NULL; cur = cur->right) {
+		nodes.push_back(cur);
+		totals.push_back(totals.back() + cur->hits + 1);
+	}
+	root = reweighHelper(nodes, totals, 0, (int)nodes.size());
+	sinceReweigh = 0;
+}
+
+//------------------------------  tooDeep  --------------------------------
+// returns true if a WEIGHTED insert that made a Node at the depth passed
+// should rebuild a subtree on its path: deeper than 2 log2(size()) plus
+// DEPTHSLACK.  That is deeper than log base 3/2 of size(), so some Node
+// on the path is a scapegoat; the slack leaves room for the hot keys a
+// reweigh lifts, which push cold ones below log2(size())
+// Preconditions:   none
+// Postconditions:  none
+bool BinTree::tooDeep(int depth) const {
+	int levels = 0;
+	for (int keys = size(); keys > 1; keys /= 2)
+		levels++;
+	return depth > 2 * levels + DEPTHSLACK;
+}
+
+//----------------------------  isScapegoat  ------------------------------
+// returns true if a Node's larger child holds more than two thirds of its
+// subtree, so that rebuilding the Node's subtree shortens it
+// Preconditions:   none
+// Postconditions:  none
+bool BinTree::isScapegoat(Node* cur) {
+	int larger = max(sizeOf(cur->left), sizeOf(cur->right));
+	return 3 * larger > 2 * sizeOf(cur);
+}
+
+//---------------------------  reweighSubtree  ----------------------------
+// rebuilds one subtree by hit count, as reweigh rebuilds the tree.  The
+// Nodes are gathered in order with a stack instead of a vine, and its
+// tombstones stay, since they are counted for the whole tree; its
+// ancestors are updated by the insert returning through them.  Each
+// rebuild of m Nodes follows Omega(m) inserts below it, as in a
+// scapegoat tree, so inserts cost O(log n) amortized
+// Preconditions:   the Node's parent, if any, is only held by this tree
+// Postconditions:  same NodeDatas; the subtree's hits are halved
+void BinTree::reweighSubtree(Node*& cur) {
+	unshareAll(cur);
+	vector<Node*> nodes, path;
+	vector<long long> totals(1, 0);
+	nodes.reserve(sizeOf(cur));
+	for (Node* next = cur;;) {
+		for (; next != NULL; next = next->left)
+			path.push_back(next);
+		if (path.empty())
+			break;
+		next = path.back();
+		path.pop_back();
+		nodes.push_back(next);
+		totals.push_back(totals.back() + next->hits + 1);
+		next = next->right;
+	}
+	cur = reweighHelper(nodes, totals, 0, (int)nodes.size());
+}
+
+//----------------------------  reweighHelper  ----------------------------
+// recursive helper function for reweigh; roots the Nodes in [low, high)
+// of the in order vector at the one whose share of the running total
+// holds the middle of the range's weight, so each side weighs at most
+// half; recursion is as deep as the tree it builds, O(log total weight)
+// Preconditions:   the totals are running sums of the Nodes' weights,
+//			totals[i] being the weight of the Nodes before i
+// Postconditions:  returns the root of the rebuilt subtree
+BinTree::Node* BinTree::reweighHelper(const vector<Node*>& nodes,
+									  const vector<long long>& totals,
+									  int low, int high) {
+	if (low >= high)
+		return NULL;
+	long long middle = (totals[low] + totals[high]) / 2;
+	int at = upper_bound(totals.begin() + low + 1,
+						 totals.begin() + high + 1, middle) -
+			 totals.begin() - 1;
+	Node* cur = nodes[at];
+	cur->hits = cur->hits / 2;
+	cur->left = reweighHelper(nodes, totals, low, at);
+	cur->right = reweighHelper(nodes, totals, at + 1, high);
+	updateNode(cur);
+	return cur;
 }
 
 //----------------------------  retrieveHelper  ---------------------------
 // recursive helper function for the retrieve function, and a general find 
 // tool.  You have the option to have a NodeData* to the object found, or
 // a Node* to the object found, or both, by passing in NULL ptrs
-// Preconditions:   NodeData to find, NodeData* to point to found, Node* to
-//			point to found, and root are passed
+// Preconditions:   Probe of NodeData to find, NodeData* to point to
+//			found, Node* to point to found, and root are passed
 // Postconditions:  NodeDataPtr will point to found the NodeData if found,
 //			NodePtr will point to found NodeData's Node, and will return
 //			true if found
-bool BinTree::retrieveHelper(const NodeData& toFind, NodeData*& ptr,
+bool BinTree::retrieveHelper(Probe& probe, NodeData*& ptr,
 				             Node* cur) const {
 	if (cur != NULL) {
-		if (toFind == *cur->data) {
+		int order = compareProbe(probe, cur);
+		if (order == 0) {
+			if (cur->dead)
+				return false;
 			ptr = cur->data;
+			if (balance == WEIGHTED)
+				noteHit(cur);
 			return true;
-		} else if (toFind < *cur->data)
-			return retrieveHelper(toFind, ptr, cur->left);
+		} else if (order < 0)
+			return retrieveHelper(probe, ptr, cur->left);
 		else //toFind > cur->data) 
-			return retrieveHelper(toFind, ptr, cur->right);
+			return retrieveHelper(probe, ptr, cur->right);
 	} else return false;
 }
 
@@ -178,76 +1356,188 @@ bool BinTree::retrieveHelper(const NodeData& toFind, NodeData*& ptr,
 //			object's depth, if it is in the tree
 // Postconditions:  none
 int BinTree::getDepth(const NodeData& toFind) const {
-	int depth = 0; //-1 means not found
-	getDepthHelper(toFind, root, depth, 1);
-	return depth;
+	if (filteredOut(toFind))
+		return 0;
+	Probe probe = makeProbe(toFind);
+	return getDepthHelper(probe, root, 1); //0 means not found
 }
 
 //---------------------------  getDepthtHelper  ---------------------------
-// recursive helper function for the getDepth function.  Searches the tree
-// by inorder traversal, and keeps track of depth as it goes.  sets
-// foundDepth to the depth of the object found, if found
-// Preconditions:   the node which you want to find the depth of, the root,
-// 			the int you want the foundDepth stored in, and the root depth
-//			(1) is passed
-// Postconditions:  none
-void BinTree::getDepthHelper(const NodeData& toFind, Node* cur,
-						    int& foundDepth, int depth) const {
-	if (cur != NULL) {
-		getDepthHelper(toFind, cur->left, foundDepth, depth+1);
-		if (toFind == *cur->data)
-			foundDepth = depth;
-		getDepthHelper(toFind, cur->right, foundDepth, depth+1);
+// recursive helper function for the getDepth function.  Follows the search
+// path for the object, keeping track of depth as it goes, and returns the
+// depth of the object found, or 0 if it is not in the tree
+// Preconditions:   a Probe of the value to find the depth of, the root,
+//			and the root depth (1) is passed
+// Postconditions:  none
+int BinTree::getDepthHelper(Probe& probe, Node* cur, int depth) const {
+	if (cur == NULL)
+		return 0;
+	int order = compareProbe(probe, cur);
+	if (order == 0)
+		return cur->dead ? 0 : depth;
+	else if (order < 0)
+		return getDepthHelper(probe, cur->left, depth+1);
+	else //toFind > cur->data
+		return getDepthHelper(probe, cur->right, depth+1);
+}
+
+//-------------------------------- size -----------------------------------
+// Returns the number of NodeDatas in the tree
+// Preconditions:   every Node's size is correct
+// Postconditions:  none
+int BinTree::size() const {
+	return sizeOf(root);
+}
+
+//-------------------------------- rank -----------------------------------
+// Returns the number of NodeDatas in the tree smaller than the parameter,
+// which is the parameter's in order index if it is in the tree; adds up
+// the left subtree sizes passed on the way down the search path
+// Preconditions:   every Node's size is correct
+// Postconditions:  none
+int BinTree::rank(const NodeData& toFind) const {
+	int smaller = 0;
+	Node* cur = root;
+	while (cur != NULL) {
+		if (*cur->data < toFind) {
+			smaller += sizeOf(cur->left) + !cur->dead;
+			cur = cur->right;
+		} else
+			cur = cur->left;
+	}
+	return smaller;
+}
+
+//------------------------------- select ----------------------------------
+// Returns the NodeData at a given in order index, counting from 0, or
+// NULL if the index is not less than size(); uses the left subtree sizes
+// to pick a side at each level
+// Preconditions:   every Node's size is correct
+// Postconditions:  the NodeData returned is still owned by the tree
+NodeData* BinTree::select(int index) const {
+	if (index < 0 || index >= sizeOf(root))
+		return NULL;
+	Node* cur = root;
+	for (;;) {
+		int leftSize = sizeOf(cur->left);
+		if (index < leftSize)
+			cur = cur->left;
+		else if (index == leftSize && !cur->dead)
+			return cur->data;
+		else {
+			index -= leftSize + !cur->dead;
+			cur = cur->right;
+		}
+	}
+}
+
+//---------------------------- exportInorder ------------------------------
+// Fills an array of NodeData* by using an inorder traversal of the tree,
+// leaving the tree as it is; returns the number of entries written
+// Preconditions:   the int passed is the capacity of the array
+// Postconditions:  the first min(size(), capacity) NodeDatas are in the
+//       array, and are still owned by the tree
+int BinTree::exportInorder(NodeData* toFill[], int capacity) const {
+	int written = 0;
+	exportInorderHelper(toFill, root, written, capacity);
+	return written;
+}
+
+//---------------------------- exportInorder ------------------------------
+// Replaces the contents of a vector with the NodeData* of an inorder
+// traversal of the tree, leaving the tree as it is
+// Preconditions:   none
+// Postconditions:  the vector holds size() NodeDatas, still owned by the
+//       tree
+void BinTree::exportInorder(vector<NodeData*>& toFill) const {
+	toFill.resize(size());
+	if (!toFill.empty())
+		exportInorder(&toFill[0], (int)toFill.size());
+}
+
+//------------------------  exportInorderHelper  --------------------------
+// recursive helper function for exportInorder; fills an array of NodeData*
+// by an inorder traversal, stopping once the capacity is reached
+// Preconditions:   the index starts at 0, the last int is the capacity
+// Postconditions:  index is the number of entries written
+void BinTree::exportInorderHelper(NodeData* toFill[], Node* cur, int& index,
+								  int capacity) const {
+	if (cur != NULL && index < capacity) {
+		exportInorderHelper(toFill, cur->left, index, capacity);
+		if (index < capacity && !cur->dead)
+			toFill[index++] = cur->data;
+		exportInorderHelper(toFill, cur->right, index, capacity);
 	}
 }
 
 //---------------------------- bstreeToArray ------------------------------
 // A routine fills an array of NodeData* by using an inorder traversal of
 // the tree, emptying the tree as well
-// Preconditions:   tree has no more than 100 nodes -- only size 100 array
-// Postconditions:  tree is empty
+// Preconditions:   array has room for size() entries
+// Postconditions:  tree is empty; the array owns the NodeDatas
 void BinTree::bstreeToArray(NodeData* toFill[]) {
 	int startingIndex = 0;
+	unshareAll(root); //the Nodes are freed as they are emptied
 	bstreeToArrayHelper(toFill, root, startingIndex);
 	root = NULL;
+	tombstones = 0;
+	if (filter != NULL)
+		filter->clear();
 }
 
 //------------------------  bstreeToArrayHelper  --------------------------
 // recursive helper function for bstreeToArray; fills an array of NodeData*
-// by builds a balanced BinTree from a sorted array of NodeData*
-// Preconditions:   array has no less than 100 nodes
+// by using an inorder traversal of the tree, emptying the tree as well
+// Preconditions:   array has room for every node
 // Postconditions:  tree is empty
 void BinTree::bstreeToArrayHelper(NodeData* toFill[], Node* cur,
 								  int& index) {
 	if (cur != NULL) {
+		Node* right = cur->right; //cur is freed before its right subtree
 		bstreeToArrayHelper(toFill, cur->left, index);
-		bstreeToArrayHelper(toFill, cur->right, index);
-		if (index < 100) {
+		if (cur->dead) //a tombstone's NodeData goes with it
+			destroyData(cur);
+		else if (cur->ownsData) { //arena copies would not outlive makeEmpty
+			toFill[index++] = new NodeData(*cur->data);
+			destroyData(cur);
+		} else
 			toFill[index++] = &*cur->data;
-		}
-		delete cur;
+		freeNode(cur);
+		bstreeToArrayHelper(toFill, right, index);
 	}
 }
 
 //---------------------------- arrayToBSTree ------------------------------
 // A routine builds a balanced BinTree from a sorted array of NodeData* 
-// Preconditions:   array is of size 100
+// Preconditions:   the NodeDatas in the array are followed by a NULL
 // Postconditions:  array is filled with NULLs; the root (recursively) is
 //       at (low+high)/2 where low is the lowest subscript of the array
 //       range and high is the highest
 void BinTree::arrayToBSTree(NodeData* toCopy[]) {
-	makeEmpty();
 	int objectCount;
 	for (objectCount = 0; toCopy[objectCount] != NULL; objectCount++);
-	arrayToBSTreeHelper(toCopy, root, 0, objectCount); //array size 100
-	for (int i = 0; i <= objectCount; i++) {
-		toCopy[i] = NULL;
-	}
+	arrayToBSTree(toCopy, objectCount);
 }
 
-//------------------------  bstreeToArrayHelper  --------------------------
-// recursive helper function for arrayToBSTree; builds a balanced BinTree
-// from a sorted array of NodeData*
+//---------------------------- arrayToBSTree ------------------------------
+// A routine builds a balanced BinTree from the first count entries of a
+// sorted array of NodeData*
+// Preconditions:   the int passed is the number of NodeDatas in the array
+// Postconditions:  those entries are set to NULL; the root (recursively)
+//       is at (low+high)/2 as above
+void BinTree::arrayToBSTree(NodeData* toCopy[], int objectCount) {
+	makeEmpty();
+	arrayToBSTreeHelper(toCopy, root, 0, objectCount, false);
+	for (int i = 0; i < objectCount; i++) {
+		toCopy[i] = NULL;
+	}
+	if (filter != NULL)
+		rebuildFilter();
+}
+
+//------------------------  arrayToBSTreeHelper  --------------------------
+// recursive helper function for arrayToBSTree and bulkLoad; builds a
+// balanced BinTree from the NodeData* in [low, high) of a sorted array
 // ***********************************NOTE*********************************
 // I couldn't figure out how to get my tree to look exactly like the sample
 // output, but the tree I produce is BALANCED and COMPLETE (all levels
@@ -258,18 +1548,661 @@ void BinTree::arrayToBSTree(NodeData* toCopy[]) {
 // implementation is just as good if not better than the sample output tree
 // Nonetheless, I couldn't replicate the sample output, so I did my best :)
 // ***********************************NOTE*********************************
-// Preconditions:   array is of size 100
-// Postconditions:  array is all NULL
+// Preconditions:   the bool says whether the NodeDatas live in the arena
+// Postconditions:  the subtree holds every NodeData in the range
 void BinTree::arrayToBSTreeHelper(NodeData* toCopy[], Node*& cur,
-								  int low, int high) {
+								  int low, int high, bool inArena) {
 	if (low < high) {
 		int index = (low+high)/2;
-		cur = new Node;
-		cur->data = &*toCopy[index];
+		cur = createNode(toCopy[index]);
+		cur->ownsData = inArena;
+		arrayToBSTreeHelper(toCopy, cur->left, low, index, inArena);
+		arrayToBSTreeHelper(toCopy, cur->right, index+1, high, inArena);
+		updateNode(cur);
+	}
+}
+
+//------------------------------ bulkLoad ---------------------------------
+// Replaces the contents of the tree with one NodeData per distinct string
+// in the batch.  The batch is sorted by pointer (in parallel for large
+// batches) and deduplicated before anything is allocated, then built with
+// the same midpoint construction as arrayToBSTree; O(n log n) overall.
+// A counting tree counts each string as often as the batch holds it
+// Preconditions:   none
+// Postconditions:  returns size(); the NodeDatas live in the tree's arena
+int BinTree::bulkLoad(const vector<string>& batch) {
+	makeEmpty();
+	vector<const string*> keys(batch.size());
+	for (size_t i = 0; i < batch.size(); i++)
+		keys[i] = &batch[i];
+	sortBatch(keys);
+	int unique = 0; //duplicates are dropped before any NodeData exists
+	vector<int> runs;   //times each distinct string came, if counting
+	for (size_t i = 0; i < keys.size(); i++) {
+		if (unique == 0 || *keys[unique-1] != *keys[i]) {
+			keys[unique++] = keys[i];
+			if (counting)
+				runs.push_back(1);
+		} else if (counting)
+			runs.back()++;
+	}
+	vector<NodeData*> sorted(unique);
+	for (int i = 0; i < unique; i++)
+		sorted[i] = copyData(*keys[i]);
+	if (unique > 0)
+		arrayToBSTreeHelper(&sorted[0], root, 0, unique, true);
+	for (size_t i = 0; i < runs.size(); i++) {
+		if (runs[i] > 1) {
+			Probe probe = makeProbe(*sorted[i]);
+			findNode(probe)->count = runs[i];
+		}
+	}
+	if (filter != NULL)
+		rebuildFilter();
+	return unique;
+}
+
+//------------------------------- ingest ----------------------------------
+// Adds a NodeData for every token of the Tokenizer's next record, in the
+// order they come, and returns how many were new.  Each token is looked
+// up through one reused NodeData, whose string only grows for a token
+// longer than any before; only a new key is copied into the arena
+// Preconditions:   none
+// Postconditions:  the record and its "$$" are consumed; the tree is the
+//       one operator>> would build from the same record
+int BinTree::ingest(Tokenizer& source) {
+	int added = 0;
+	vector<Tokenizer::Token> batch;
+	NodeData key;
+	while (source.nextBatch(batch) > 0) {
+		for (size_t i = 0; i < batch.size(); i++) {
+			key.setData(batch[i].chars, batch[i].length);
+			if (insertCopy(key))
+				added++;
+		}
+	}
+	return added;
+}
+
+//----------------------------- unionWith ---------------------------------
+// Adds a copy of every NodeData of the parameter this tree does not hold.
+// New Nodes come from the tree's arena, or, when it is shared with other
+// trees, from a private Arena adopted under the lock at the end
+// Preconditions:   none
+// Postconditions:  this tree holds the union; the parameter is unchanged
+void BinTree::unionWith(const BinTree& other) {
+	if (&other == this || other.root == NULL)
+		return;
+	if (other.tombstones > 0) { //split would take them for keys
+		BinTree compacted(other);
+		compacted.compact();
+		unionWith(compacted);
+		return;
+	}
+	compact();
+	if (share != NULL)
+		unshareAll(root); //split and join relink the Nodes
+	Arena built;
+	Arena& memory = share != NULL ? built : *arena;
+	root = unionHelper(root, other.root, memory, forkLevels());
+	if (share != NULL) {
+		lock_guard<mutex> hold(share->lock);
+		arena->adopt(built);
+	}
+	if (filter != NULL) //adding the keys this tree held already is harmless
+		filterHelper(other.root);
+}
+
+//----------------------------- intersect ---------------------------------
+// Removes every NodeData the parameter does not hold; the dropped Nodes
+// are freed after the threads are done, since the arena is not thread
+// safe
+// Preconditions:   none
+// Postconditions:  this tree holds the intersection; the parameter is
+//       unchanged
+void BinTree::intersect(const BinTree& other) {
+	if (&other == this)
+		return;
+	if (other.tombstones > 0) {
+		BinTree compacted(other);
+		compacted.compact();
+		intersect(compacted);
+		return;
+	}
+	compact();
+	if (share != NULL)
+		unshareAll(root);
+	vector<Node*> dropped;
+	root = intersectHelper(root, other.root, dropped, forkLevels());
+	for (size_t i = 0; i < dropped.size(); i++)
+		makeEmptyHelper(dropped[i], false);
+}
+
+//----------------------------- difference --------------------------------
+// Removes every NodeData the parameter holds; as intersect
+// Preconditions:   none
+// Postconditions:  this tree holds the difference; the parameter is
+//       unchanged
+void BinTree::difference(const BinTree& other) {
+	if (&other == this) {
+		makeEmpty();
+		return;
+	}
+	if (other.tombstones > 0) {
+		BinTree compacted(other);
+		compacted.compact();
+		difference(compacted);
+		return;
+	}
+	compact();
+	if (share != NULL)
+		unshareAll(root);
+	vector<Node*> dropped;
+	root = differenceHelper(root, other.root, dropped, forkLevels());
+	for (size_t i = 0; i < dropped.size(); i++)
+		makeEmptyHelper(dropped[i], false);
+}
+
+//----------------------------  unionHelper  ------------------------------
+// recursive helper for unionWith; splits this tree's subtree around the
+// other subtree's root key and unions the halves, on two threads while
+// forks remain and the subtrees are large.  The forked half allocates
+// from an Arena of its own, adopted once it is joined
+// Preconditions:   new Nodes come from the Arena passed, used by no
+//			other thread
+// Postconditions:  returns the root of the union
+BinTree::Node* BinTree::unionHelper(Node* mine, Node* theirs, Arena& memory,
+									int forks) const {
+	if (theirs == NULL)
+		return mine;
+	if (mine == NULL)
+		return copyTree(theirs, memory);
+	bool fork = forks > 0 && sizeOf(mine) + sizeOf(theirs) >= PARALLELSET;
+	Node *left, *found, *right;
+	split(mine, *theirs->data, left, found, right);
+	if (found == NULL) { //only the other tree holds the key
+		found = initNode(memory.allocate(sizeof(Node)),
+						 copyData(*theirs->data, memory));
+		found->ownsData = true;
+		found->count = theirs->count;
+	}
+	if (fork) {
+		Arena forked;
+		forkJoin([&]() {
+			left = unionHelper(left, theirs->left, memory, forks - 1);
+		}, [&]() {
+			right = unionHelper(right, theirs->right, forked, forks - 1);
+		});
+		memory.adopt(forked);
+	} else {
+		left = unionHelper(left, theirs->left, memory, forks);
+		right = unionHelper(right, theirs->right, memory, forks);
+	}
+	return join(left, found, right);
+}
+
+//---------------------------  intersectHelper  ---------------------------
+// recursive helper for intersect; as unionHelper, handing the subtrees
+// it drops to the vector to be freed once every thread is done
+// Preconditions:   the vector is used by no other thread
+// Postconditions:  returns the root of the intersection
+BinTree::Node* BinTree::intersectHelper(Node* mine, Node* theirs,
+		vector<Node*>& dropped, int forks) const {
+	if (mine == NULL)
+		return NULL;
+	if (theirs == NULL) {
+		dropped.push_back(mine);
+		return NULL;
+	}
+	bool fork = forks > 0 && sizeOf(mine) + sizeOf(theirs) >= PARALLELSET;
+	Node *left, *found, *right;
+	split(mine, *theirs->data, left, found, right);
+	if (fork) {
+		vector<Node*> forked;
+		forkJoin([&]() {
+			left = intersectHelper(left, theirs->left, dropped, forks - 1);
+		}, [&]() {
+			right = intersectHelper(right, theirs->right, forked, forks - 1);
+		});
+		dropped.insert(dropped.end(), forked.begin(), forked.end());
+	} else {
+		left = intersectHelper(left, theirs->left, dropped, forks);
+		right = intersectHelper(right, theirs->right, dropped, forks);
+	}
+	if (found == NULL)
+		return joinTwo(left, right);
+	return join(left, found, right);
+}
+
+//--------------------------  differenceHelper  ---------------------------
+// recursive helper for difference; as intersectHelper
+// Preconditions:   the vector is used by no other thread
+// Postconditions:  returns the root of the difference
+BinTree::Node* BinTree::differenceHelper(Node* mine, Node* theirs,
+		vector<Node*>& dropped, int forks) const {
+	if (mine == NULL || theirs == NULL)
+		return mine;
+	bool fork = forks > 0 && sizeOf(mine) + sizeOf(theirs) >= PARALLELSET;
+	Node *left, *found, *right;
+	split(mine, *theirs->data, left, found, right);
+	if (found != NULL) //both trees hold the key
+		dropped.push_back(found);
+	if (fork) {
+		vector<Node*> forked;
+		forkJoin([&]() {
+			left = differenceHelper(left, theirs->left, dropped, forks - 1);
+		}, [&]() {
+			right = differenceHelper(right, theirs->right, forked, forks-1);
+		});
+		dropped.insert(dropped.end(), forked.begin(), forked.end());
+	} else {
+		left = differenceHelper(left, theirs->left, dropped, forks);
+		right = differenceHelper(right, theirs->right, dropped, forks);
+	}
+	return joinTwo(left, right);
+}
+
+//-----------------------------  copyTree  --------------------------------
+// recursive helper function for copy constructor, assignment operator
+// and unionWith; copies a subtree of another tree with Nodes and
+// NodeDatas from the Arena passed; large subtrees are copied by
+// forkCopyHelper
+// Preconditions:   the Arena is used by no other thread
+// Postconditions:  returns the copy
+BinTree::Node* BinTree::copyTree(Node* other, Arena& memory) const {
+	if (other == NULL)
+		return NULL;
+	Node* cur = initNode(memory.allocate(sizeof(Node)),
+						 copyData(*other->data, memory));
+	cur->ownsData = true;
+	cur->count = other->count;
+	cur->dead = other->dead;
+	if (parallelWalk(other))
+		forkCopyHelper(cur, other, memory);
+	else {
+		cur->left = copyTree(other->left, memory);
+		cur->right = copyTree(other->right, memory);
+	}
+	updateNode(cur);
+	return cur;
+}
+
+//---------------------------  forkCopyHelper  ----------------------------
+// helper for copyTree; copies the two subtrees of a Node on the pool, the
+// right one into an Arena of its own, adopted once it is joined
+// Preconditions:   as copyTree; the first Node is the copy of the second
+// Postconditions:  the copy's children are set
+void BinTree::forkCopyHelper(Node* cur, Node* other, Arena& memory) const {
+	Arena forked;
+	forkJoin([&]() { cur->left = copyTree(other->left, memory); },
+			 [&]() { cur->right = copyTree(other->right, forked); });
+	memory.adopt(forked);
+}
+
+//-------------------------------  split  ---------------------------------
+// splits a subtree around a key into the subtree of smaller keys, the
+// Node holding the key if there is one, and the subtree of larger keys;
+// each Node on the search path is unshared, then joined back onto the
+// side it belongs to
+// Preconditions:   the subtree's parent, if any, is only held by this
+//			tree, and no longer points to it
+// Postconditions:  the Nodes are reused; the found Node has no children
+void BinTree::split(Node* cur, const NodeData& key, Node*& left,
+					Node*& found, Node*& right) const {
+	if (cur == NULL) {
+		left = NULL;
+		found = NULL;
+		right = NULL;
+		return;
+	}
+	unshare(cur); //its children are about to be relinked
+	int order = key.compare(*cur->data);
+	if (order == 0) {
+		left = cur->left;
+		right = cur->right;
+		found = cur;
 		cur->left = NULL;
 		cur->right = NULL;
-		arrayToBSTreeHelper(toCopy, cur->left, low, index);
-		arrayToBSTreeHelper(toCopy, cur->right, index+1, high);
+		updateNode(cur);
+	} else if (order < 0) {
+		Node* between;
+		split(cur->left, key, left, found, between);
+		right = join(between, cur, cur->right);
+	} else {
+		Node* between;
+		split(cur->right, key, between, found, right);
+		left = join(cur->left, cur, between);
+	}
+}
+
+//--------------------------------  join  ---------------------------------
+// joins two AVL subtrees and a Node whose key lies between them into one
+// AVL subtree; when their heights are close the Node simply becomes
+// their parent
+// Preconditions:   every key of the first subtree is smaller than the
+//			Node's, and every key of the second larger; the Node
+//			and the subtrees' roots are held by nothing else in
+//			this tree
+// Postconditions:  returns the root of the joined subtree
+BinTree::Node* BinTree::join(Node* left, Node* middle, Node* right) const {
+	unshare(middle);
+	if (heightOf(left) > heightOf(right) + 1)
+		return joinRight(left, middle, right);
+	if (heightOf(right) > heightOf(left) + 1)
+		return joinLeft(left, middle, right);
+	middle->left = left;
+	middle->right = right;
+	updateNode(middle);
+	return middle;
+}
+
+//-----------------------------  joinRight  -------------------------------
+// join, for a first subtree more than one taller than the second; walks
+// down its right spine to a subtree short enough to hang the rest on,
+// then rotates on the way back up wherever the spine became too tall
+// Preconditions:   as join
+// Postconditions:  as join
+BinTree::Node* BinTree::joinRight(Node* left, Node* middle,
+								  Node* right) const {
+	unshare(left); //the spine walked down is relinked
+	Node* inner = left->right;
+	if (heightOf(inner) <= heightOf(right) + 1) {
+		middle->left = inner;
+		middle->right = right;
+		updateNode(middle);
+		left->right = middle;
+		if (heightOf(middle) > heightOf(left->left) + 1) { //double rotation
+			unshare(middle->left);
+			rotateRight(left->right);
+			rotateLeft(left);
+		} else
+			updateNode(left);
+		return left;
+	}
+	left->right = joinRight(inner, middle, right);
+	if (heightOf(left->right) > heightOf(left->left) + 1)
+		rotateLeft(left);
+	else
+		updateNode(left);
+	return left;
+}
+
+//-----------------------------  joinLeft  --------------------------------
+// join, for a second subtree more than one taller than the first; the
+// mirror image of joinRight
+// Preconditions:   as join
+// Postconditions:  as join
+BinTree::Node* BinTree::joinLeft(Node* left, Node* middle,
+								 Node* right) const {
+	unshare(right);
+	Node* inner = right->left;
+	if (heightOf(inner) <= heightOf(left) + 1) {
+		middle->left = left;
+		middle->right = inner;
+		updateNode(middle);
+		right->left = middle;
+		if (heightOf(middle) > heightOf(right->right) + 1) {
+			unshare(middle->right);
+			rotateLeft(right->left);
+			rotateRight(right);
+		} else
+			updateNode(right);
+		return right;
+	}
+	right->left = joinLeft(left, middle, inner);
+	if (heightOf(right->left) > heightOf(right->right) + 1)
+		rotateRight(right);
+	else
+		updateNode(right);
+	return right;
+}
+
+//------------------------------  joinTwo  --------------------------------
+// joins two AVL subtrees with no Node between them, by taking the
+// largest Node out of the first to put between them
+// Preconditions:   as join
+// Postconditions:  returns the root of the joined subtree
+BinTree::Node* BinTree::joinTwo(Node* left, Node* right) const {
+	if (left == NULL)
+		return right;
+	Node* last;
+	Node* rest = splitLast(left, last);
+	return join(rest, last, right);
+}
+
+//-----------------------------  splitLast  -------------------------------
+// takes the Node with the largest key out of a subtree, joining each
+// Node on the right spine back onto what remains
+// Preconditions:   the subtree is not empty; as join
+// Postconditions:  returns the rest of the subtree; the Node taken out
+//			is passed back in the second parameter
+BinTree::Node* BinTree::splitLast(Node* cur, Node*& last) const {
+	unshare(cur);
+	if (cur->right == NULL) {
+		last = cur;
+		return cur->left;
+	}
+	Node* rest = splitLast(cur->right, last);
+	return join(cur->left, cur, rest);
+}
+
+//----------------------------  forkLevels  -------------------------------
+// returns how many levels of a recursion should fork a thread: enough
+// that every core gets a subtree, plus one so an uneven split still
+// keeps them busy.  A pool balances its tasks itself, so with one every
+// level large enough forks
+// Preconditions:   none
+// Postconditions:  none
+int BinTree::forkLevels() const {
+	if (pool != NULL)
+		return 64; //deeper than any AVL tree that fits in memory
+	int levels = 0;
+	for (unsigned cores = thread::hardware_concurrency(); cores > 1;
+		 cores = (cores + 1) / 2)
+		levels++;
+	return levels == 0 ? 0 : levels + 1;
+}
+
+//------------------------------  forkJoin  -------------------------------
+// runs two tasks at once and returns when both are done: on the tree's
+// pool if it has one, else the second on a thread of its own
+// Preconditions:   the tasks do not depend on each other
+// Postconditions:  both tasks have run
+void BinTree::forkJoin(const function<void()>& first,
+					   const function<void()>& second) const {
+	if (pool != NULL) {
+		pool->forkJoin(first, second);
+		return;
+	}
+	thread worker(second);
+	first();
+	worker.join();
+}
+
+//----------------------------  parallelWalk  -----------------------------
+// returns true if a whole tree walk should fork at the subtree passed:
+// the tree has a pool and the subtree is large enough to pay for a task
+// Preconditions:   none
+// Postconditions:  none
+bool BinTree::parallelWalk(Node* cur) const {
+	return pool != NULL && sizeOf(cur) >= PARALLELWALK;
+}
+
+//----------------------------  sortBatch  --------------------------------
+// sorts pointers to strings by the strings they point to; batches of at
+// least PARALLELSORT strings are sorted in chunks on separate threads and
+// merged pairwise, also in parallel
+// Preconditions:   none
+// Postconditions:  the pointers are in ascending order of string
+void BinTree::sortBatch(vector<const string*>& keys) {
+	struct ByString {
+		bool operator()(const string* a, const string* b) const {
+			return *a < *b;
+		}
+	};
+	size_t chunks = thread::hardware_concurrency();
+	if (chunks > keys.size() / PARALLELSORT)
+		chunks = keys.size() / PARALLELSORT;
+	if (chunks < 2) {
+		sort(keys.begin(), keys.end(), ByString());
+		return;
+	}
+	vector<size_t> bounds(chunks + 1); //chunk i is [bounds[i], bounds[i+1])
+	for (size_t i = 0; i <= chunks; i++)
+		bounds[i] = keys.size() * i / chunks;
+	vector<thread> workers;
+	for (size_t i = 0; i < chunks; i++)
+		workers.push_back(thread([&keys, &bounds, i]() {
+			sort(keys.begin() + bounds[i], keys.begin() + bounds[i+1],
+				 ByString());
+		}));
+	for (size_t i = 0; i < workers.size(); i++)
+		workers[i].join();
+	for (size_t width = 1; width < chunks; width *= 2) { //merge neighbours
+		workers.clear();
+		for (size_t i = 0; i + width < chunks; i += 2 * width) {
+			size_t first = bounds[i], middle = bounds[i+width];
+			size_t last = bounds[min(i + 2 * width, chunks)];
+			workers.push_back(thread([&keys, first, middle, last]() {
+				inplace_merge(keys.begin() + first, keys.begin() + middle,
+							  keys.begin() + last, ByString());
+			}));
+		}
+		for (size_t i = 0; i < workers.size(); i++)
+			workers[i].join();
+	}
+}
+
+//------------------------------- freeze ----------------------------------
+// Returns a read-only snapshot of the tree in Eytzinger order, which
+// answers retrieve, getDepth and operator<< as this tree does now
+// Preconditions:   none
+// Postconditions:  the snapshot holds copies; this tree is unchanged
+FrozenTree BinTree::freeze() const {
+	vector<NodeData*> sorted;
+	vector<int> depths;
+	sorted.reserve(size());
+	depths.reserve(size());
+	freezeHelper(root, 1, sorted, depths);
+	return FrozenTree(sorted, depths);
+}
+
+//-------------------------------- save -----------------------------------
+// Writes the tree to a file MappedTree::open maps and queries in place;
+// the NodeDatas are collected as freeze collects them
+// Preconditions:   none
+// Postconditions:  the file is replaced; this tree is unchanged
+bool BinTree::save(const char* path) const {
+	vector<NodeData*> sorted;
+	vector<int> depths;
+	sorted.reserve(size());
+	depths.reserve(size());
+	freezeHelper(root, 1, sorted, depths);
+	return MappedTree::write(path, sorted, depths);
+}
+
+//----------------------------  freezeHelper  -----------------------------
+// recursive helper function for freeze and save; collects the NodeDatas
+// in order along with the depth of each
+// Preconditions:   the root and the root depth (1) are passed
+// Postconditions:  both vectors have one more entry per Node
+void BinTree::freezeHelper(Node* cur, int depth, vector<NodeData*>& sorted,
+						   vector<int>& depths) const {
+	if (cur != NULL) {
+		freezeHelper(cur->left, depth+1, sorted, depths);
+		if (!cur->dead) {
+			sorted.push_back(cur->data);
+			depths.push_back(depth);
+		}
+		freezeHelper(cur->right, depth+1, sorted, depths);
+	}
+}
+
+//------------------------------ rebalance --------------------------------
+// Rebuilds the tree into a complete tree in place, reusing its Nodes:
+// rotates it into a sorted vine, then compresses the vine back into a
+// tree (Day-Stout-Warren).  Linear time, no allocation; the tombstones
+// are freed on the way
+// Preconditions:   none
+// Postconditions:  same NodeDatas, height is floor(log2(size())) + 1
+void BinTree::rebalance() {
+	unshareAll(root); //every Node is relinked
+	Node pseudoRoot; //lives on the stack; only its right link is used
+	pseudoRoot.left = NULL;
+	pseudoRoot.right = root;
+	int count = treeToVine(&pseudoRoot);
+	count -= purgeVine(&pseudoRoot);
+	vineToTree(&pseudoRoot, count);
+	root = pseudoRoot.right;
+	updateSubtree(root);
+}
+
+//----------------------------  treeToVine  -------------------------------
+// rotates right until no Node has a left child, turning the tree hanging
+// off the pseudo root's right link into a sorted list along right links
+// Preconditions:   the pseudo root's right link holds the tree
+// Postconditions:  returns the number of Nodes in the vine
+int BinTree::treeToVine(Node* pseudoRoot) {
+	int count = 0;
+	Node* tail = pseudoRoot;
+	Node* rest = tail->right;
+	while (rest != NULL) {
+		if (rest->left == NULL) { //already on the vine, move down
+			tail = rest;
+			rest = rest->right;
+			count++;
+		} else { //rotate right to move rest's left child onto the vine
+			Node* pivot = rest->left;
+			rest->left = pivot->right;
+			pivot->right = rest;
+			rest = pivot;
+			tail->right = pivot;
+		}
+	}
+	return count;
+}
+
+//----------------------------  compressVine  -----------------------------
+// one Day-Stout-Warren pass: rotates left at every other Node down the
+// vine, for the number of rotations passed
+// Preconditions:   the pseudo root's right link holds the vine
+// Postconditions:  the vine is about half as long
+void BinTree::compressVine(Node* pseudoRoot, int rotations) {
+	Node* scanner = pseudoRoot;
+	for (int i = 0; i < rotations; i++) {
+		Node* child = scanner->right;
+		scanner->right = child->right;
+		scanner = scanner->right;
+		child->right = scanner->left;
+		scanner->left = child;
+	}
+}
+
+//----------------------------  vineToTree  -------------------------------
+// compresses a sorted vine of the given length into a complete tree; the
+// first pass only rotates the Nodes that end up on the bottom level
+// Preconditions:   the pseudo root's right link holds the vine
+// Postconditions:  the pseudo root's right link holds a complete tree;
+//			heights and sizes are not yet updated
+void BinTree::vineToTree(Node* pseudoRoot, int count) {
+	int full = 0; //largest 2^k - 1 not above count
+	while (full * 2 + 1 <= count)
+		full = full * 2 + 1;
+	compressVine(pseudoRoot, count - full);
+	for (int length = full / 2; length > 0; length /= 2)
+		compressVine(pseudoRoot, length);
+}
+
+//----------------------------  updateSubtree  ----------------------------
+// recomputes the height, size and hash of every Node in a subtree, bottom
+// up
+// Preconditions:   none
+// Postconditions:  every height, size and hash in the subtree is correct
+void BinTree::updateSubtree(Node* cur) {
+	if (cur != NULL) {
+		updateSubtree(cur->left);
+		updateSubtree(cur->right);
+		updateNode(cur);
 	}
 }
 
@@ -279,29 +2212,45 @@ void BinTree::arrayToBSTreeHelper(NodeData* toCopy[], Node*& cur,
 // Preconditions:   none
 // Postconditions:  none
 void BinTree::displaySideways() const {
-	sideways(root, 0);
+	OutputBuffer buffer(cout);
+	displaySideways(buffer, 0);
+	buffer.flush();
+	cout.flush(); //as the endl after the last line used to
+}
+
+//------------------------- displaySideways -------------------------------
+// Displays the tree sideways, as above, to an OutputBuffer, leaving out
+// the Nodes deeper than the int unless it is 0
+// Preconditions:   none
+// Postconditions:  the output may still be in the buffer
+void BinTree::displaySideways(OutputBuffer& buffer, int maxDepth) const {
+	sideways(buffer, root, 0, maxDepth);
 }
 
 //-----------------------------  sideways  --------------------------------
 // recursive helper function for display sideways
-// Preconditions:   root is passed, with level 0
+// Preconditions:   root is passed, with level 0, and the depth limit
 // Postconditions:  none
-void BinTree::sideways(Node* current, int level) const {
-   if (current != NULL) {
+void BinTree::sideways(OutputBuffer& buffer, Node* current, int level,
+					   int maxDepth) const {
+   if (current != NULL && (maxDepth == 0 || level < maxDepth)) {
       level++;
-      sideways(current->right, level);
+      sideways(buffer, current->right, level, maxDepth);
 
-      // indent for readability, 4 spaces per depth level 
-      for(int i = level; i >= 0; i--)
-          cout << "    ";
+      if (!current->dead) {           // a tombstone is left out
+         // indent for readability, 4 spaces per depth level 
+         buffer.spaces(4 * (level + 1));
 
-      cout << *current->data << endl;        // display information of object
-      sideways(current->left, level);
+         buffer.put(*current->data);  // display information of object
+         buffer.put('\n');
+      }
+      sideways(buffer, current->left, level, maxDepth);
    }
 }
 
 //------------------------------  =  --------------------------------------
-// Overloaded assignment operator; current object = parameter; deep copy
+// Overloaded assignment operator; current object = parameter; deep copy,
+// or O(1) sharing if the parameter copies on write
 // Preconditions:   none
 // Postconditions:
 //       -- this tree's nodes are deallocated, and nodes containing the
@@ -310,76 +2259,685 @@ void BinTree::sideways(Node* current, int level) const {
 BinTree& BinTree::operator=(const BinTree& rhs) {
 	if (&this->root != &rhs.root) { //if not the same object
 		makeEmpty();
-		copyTree(root, rhs.root);
+		balance = rhs.balance; //the copied shape follows rhs's policy
+		hashing = rhs.hashing;
+		counting = rhs.counting;
+		removeRatio = rhs.removeRatio;
+		tombstones = rhs.tombstones;
+		if (rhs.share != NULL) { //share rhs's Nodes, as the copy ctor does
+			if (share != rhs.share) {
+				detach();
+				joinShare(rhs.share);
+			}
+			root = rhs.root;
+			if (root != NULL)
+				root->refs++;
+		} else {
+			if (share != NULL) { //copies no longer share
+				detach();
+				arena = new Arena;
+				ownsArena = true;
+			}
+			root = copyTree(rhs.root, *arena);
+		}
+		if (filter != NULL) //this tree keeps its own filter settings
+			rebuildFilter();
+	}
+	return *this;
+}
+
+//------------------------------  =  --------------------------------------
+// Move assignment operator; takes over the parameter's Nodes in O(1)
+// Preconditions:   swap works
+// Postconditions:
+//       -- this tree's nodes are deallocated, this tree holds what the
+//          parameter held, and the parameter is left empty
+BinTree& BinTree::operator=(BinTree&& rhs) {
+	if (this != &rhs) {
+		makeEmpty();
+		swap(rhs);
 	}
 	return *this;
 }
 
+//-------------------------------- swap -----------------------------------
+// Exchanges the contents and policies of two trees in O(1)
+// Preconditions:   none
+// Postconditions:  none
+void BinTree::swap(BinTree& other) {
+	std::swap(root, other.root);
+	std::swap(balance, other.balance);
+	std::swap(arena, other.arena);
+	std::swap(ownsArena, other.ownsArena);
+	std::swap(share, other.share);
+	std::swap(hashing, other.hashing);
+	std::swap(counting, other.counting);
+	std::swap(removeRatio, other.removeRatio);
+	std::swap(tombstones, other.tombstones);
+	std::swap(pool, other.pool);
+	std::swap(counters, other.counters);
+	std::swap(filter, other.filter);
+	long long hits = sinceReweigh;
+	sinceReweigh = other.sinceReweigh.load();
+	other.sinceReweigh = hits;
+}
+
+//-------------------------------- swap -----------------------------------
+// Exchanges the contents and policies of two trees in O(1)
+// Preconditions:   none
+// Postconditions:  none
+void swap(BinTree& first, BinTree& second) {
+	first.swap(second);
+}
+
+//----------------------------- getCopying --------------------------------
+// Returns what copying this tree does
+// Preconditions:   none
+// Postconditions:  none
+BinTree::Copying BinTree::getCopying() const {
+	return share != NULL ? COPY_ON_WRITE : DEEP_COPY;
+}
+
+//----------------------------- getBalance --------------------------------
+// Returns the balancing policy of this tree
+// Preconditions:   none
+// Postconditions:  none
+BinTree::Balance BinTree::getBalance() const {
+	return balance;
+}
+
+//---------------------------- setTaskPool --------------------------------
+// Makes whole tree walks and set operations fork onto the pool passed;
+// NULL walks whole trees on the calling thread
+// Preconditions:   the pool outlives this tree, or is unset first
+// Postconditions:  copies of the tree use the pool too; assigning to the
+//       tree keeps its own
+void BinTree::setTaskPool(TaskPool* walker) {
+	pool = walker;
+}
+
+//---------------------------- getTaskPool --------------------------------
+// Returns the pool this tree forks onto, or NULL
+// Preconditions:   none
+// Postconditions:  none
+TaskPool* BinTree::getTaskPool() const {
+	return pool;
+}
+
+//--------------------------- enableHashing -------------------------------
+// Makes every Node keep a hash of its subtree's contents from now on; the
+// Nodes other trees hold are copied first, since those trees may not
+// keep hashes
+// Preconditions:   none
+// Postconditions:  isHashing() is true, and stays true for copies
+void BinTree::enableHashing() {
+	if (!hashing) {
+		unshareAll(root);
+		hashing = true;
+		hashHelper(root);
+	}
+}
+
+//-----------------------------  hashHelper  ------------------------------
+// recursive helper function for enableHashing; computes every keyHash
+// and hash of a subtree
+// Preconditions:   none
+// Postconditions:  the subtree's hashes are correct
+void BinTree::hashHelper(Node* cur) {
+	if (cur != NULL) {
+		hashHelper(cur->left);
+		hashHelper(cur->right);
+		cur->keyHash = mixHash(cur->data->hash());
+		updateNode(cur);
+	}
+}
+
+//----------------------------- isHashing ---------------------------------
+// Returns true if the tree keeps subtree hashes
+// Preconditions:   none
+// Postconditions:  none
+bool BinTree::isHashing() const {
+	return hashing;
+}
+
+//-------------------------------- hash -----------------------------------
+// Returns the hash of the tree's contents; trees holding equal NodeDatas
+// have equal hashes whatever their shapes
+// Preconditions:   isHashing() is true
+// Postconditions:  none
+unsigned long long BinTree::hash() const {
+	return hashOf(root);
+}
+
+//---------------------------- enableStats --------------------------------
+// Starts counting the inserts, retrieves, key comparisons and
+// allocations this tree makes, for getStats
+// Preconditions:   none
+// Postconditions:  isCollectingStats() is true; copies do not count
+void BinTree::enableStats() {
+	if (counters == NULL) {
+		counters = new Counters;
+		resetStats();
+	}
+}
+
+//---------------------------- disableStats -------------------------------
+// Stops counting and drops the counts
+// Preconditions:   no other thread is calling this tree
+// Postconditions:  isCollectingStats() is false
+void BinTree::disableStats() {
+	delete counters;
+	counters = NULL;
+}
+
+//-------------------------- isCollectingStats ----------------------------
+// Returns true if the tree counts calls for getStats
+// Preconditions:   none
+// Postconditions:  none
+bool BinTree::isCollectingStats() const {
+	return counters != NULL;
+}
+
+//----------------------------- resetStats --------------------------------
+// Sets every count back to 0
+// Preconditions:   none
+// Postconditions:  none
+void BinTree::resetStats() {
+	if (counters != NULL) {
+		counters->inserts = 0;
+		counters->insertComparisons = 0;
+		counters->retrieves = 0;
+		counters->retrieveComparisons = 0;
+		counters->maxSearchDepth = 0;
+		counters->allocations = 0;
+		counters->deallocations = 0;
+		counters->filterRejects = 0;
+	}
+}
+
+//------------------------------ getStats ---------------------------------
+// Returns the tree's shape, measured by one walk, and its counts.  The
+// least height of n Nodes is that of a complete tree, ceil(log2(n + 1))
+// Preconditions:   every Node's height and size are correct
+// Postconditions:  none
+BinTree::Stats BinTree::getStats() const {
+	Stats stats;
+	stats.nodeCount = size();
+	stats.tombstones = tombstones;
+	stats.height = heightOf(root);
+	long long depths = 0;
+	statsHelper(root, stats.depthHistogram, depths);
+	stats.averageDepth = stats.nodeCount == 0 ? 0 :
+						 (double)depths / stats.nodeCount;
+	int least = 0;
+	while ((1LL << least) - 1 < stats.nodeCount)
+		least++;
+	stats.heightRatio = least == 0 ? 1 : (double)stats.height / least;
+	stats.inserts = 0;
+	stats.insertComparisons = 0;
+	stats.retrieves = 0;
+	stats.retrieveComparisons = 0;
+	stats.maxSearchDepth = 0;
+	stats.allocations = 0;
+	stats.deallocations = 0;
+	stats.filterRejects = 0;
+	if (counters != NULL) {
+		stats.inserts = counters->inserts.load(memory_order_relaxed);
+		stats.insertComparisons =
+			counters->insertComparisons.load(memory_order_relaxed);
+		stats.retrieves = counters->retrieves.load(memory_order_relaxed);
+		stats.retrieveComparisons =
+			counters->retrieveComparisons.load(memory_order_relaxed);
+		stats.maxSearchDepth =
+			counters->maxSearchDepth.load(memory_order_relaxed);
+		stats.allocations = counters->allocations.load(memory_order_relaxed);
+		stats.deallocations =
+			counters->deallocations.load(memory_order_relaxed);
+		stats.filterRejects =
+			counters->filterRejects.load(memory_order_relaxed);
+	}
+	stats.filterBytes = filter != NULL ? filter->bytes() : 0;
+	stats.filterFalsePositiveRate =
+		filter != NULL ? filter->falsePositiveRate() : 0;
+	if (share != NULL) { //the arena is shared, and may be in use
+		lock_guard<mutex> hold(share->lock);
+		stats.bytesInUse = arena->bytesInUse();
+		stats.bytesReserved = arena->bytesReserved();
+	} else {
+		stats.bytesInUse = arena->bytesInUse();
+		stats.bytesReserved = arena->bytesReserved();
+	}
+	return stats;
+}
+
+//-----------------------------  statsHelper  -----------------------------
+// helper function for getStats; counts the Nodes of a subtree by depth
+// and adds up their depths, leaving tombstones out.  Walks with a stack
+// of its own instead of recursing, since the tree being measured may be
+// a degenerate one
+// Preconditions:   none
+// Postconditions:  the histogram has an entry for every depth reached
+void BinTree::statsHelper(Node* start, vector<int>& histogram,
+						  long long& depths) {
+	vector<pair<Node*, int> > pending; //Nodes to visit, with their depths
+	if (start != NULL)
+		pending.push_back(make_pair(start, 1));
+	while (!pending.empty()) {
+		Node* cur = pending.back().first;
+		int depth = pending.back().second;
+		pending.pop_back();
+		if ((int)histogram.size() < depth)
+			histogram.resize(depth, 0);
+		if (!cur->dead) {
+			histogram[depth - 1]++;
+			depths += depth;
+		}
+		if (cur->right != NULL)
+			pending.push_back(make_pair(cur->right, depth + 1));
+		if (cur->left != NULL)
+			pending.push_back(make_pair(cur->left, depth + 1));
+	}
+}
+
+//---------------------------- enableFilter -------------------------------
+// Keeps a Bloom filter of the tree's keys in front of retrieve and
+// getDepth, sized for the false positive rate passed
+// Preconditions:   the rate is in (0, 1)
+// Postconditions:  isFiltering() is true, and stays true for copies
+void BinTree::enableFilter(double rate) {
+	delete filter;
+	filter = new BloomFilter(FILTERMIN, rate);
+	rebuildFilter();
+}
+
+//---------------------------- disableFilter ------------------------------
+// Drops the filter
+// Preconditions:   none
+// Postconditions:  isFiltering() is false
+void BinTree::disableFilter() {
+	delete filter;
+	filter = NULL;
+}
+
+//----------------------------- isFiltering -------------------------------
+// Returns true if the tree keeps a Bloom filter of its keys
+// Preconditions:   none
+// Postconditions:  none
+bool BinTree::isFiltering() const {
+	return filter != NULL;
+}
+
+//----------------------------  filteredOut  ------------------------------
+// returns true if the tree's filter rules out the key passed, counting
+// it for getStats
+// Preconditions:   none
+// Postconditions:  none
+bool BinTree::filteredOut(const NodeData& key) const {
+	if (filter == NULL || filter->mayContain(mixHash(key.hash())))
+		return false;
+	if (counters != NULL)
+		counters->filterRejects.fetch_add(1, memory_order_relaxed);
+	return true;
+}
+
+//----------------------------  addToFilter  ------------------------------
+// adds a key just inserted to the filter; past the keys it was sized
+// for its false positive rate climbs, so it is rebuilt at twice the size
+// instead, O(1) amortized per insert
+// Preconditions:   the tree has a filter and holds the key
+// Postconditions:  none
+void BinTree::addToFilter(const NodeData& key) {
+	if (filter->count() >= filter->capacity())
+		rebuildFilter();
+	else
+		filter->add(mixHash(key.hash()));
+}
+
+//---------------------------  rebuildFilter  -----------------------------
+// replaces the filter with one sized for twice the tree's keys, at least
+// FILTERMIN, at the same rate, and adds them all
+// Preconditions:   the tree has a filter
+// Postconditions:  none
+void BinTree::rebuildFilter() {
+	int keys = 2 * size() > FILTERMIN ? 2 * size() : FILTERMIN;
+	BloomFilter* rebuilt = new BloomFilter(keys, filter->rate());
+	delete filter;
+	filter = rebuilt;
+	filterHelper(root);
+}
+
+//----------------------------  filterHelper  -----------------------------
+// recursive helper function for rebuildFilter and unionWith; adds the
+// keys of a subtree to the filter
+// Preconditions:   the tree has a filter
+// Postconditions:  none
+void BinTree::filterHelper(Node* cur) {
+	if (cur != NULL) {
+		if (!cur->dead)
+			filter->add(mixHash(cur->data->hash()));
+		filterHelper(cur->left);
+		filterHelper(cur->right);
+	}
+}
+
+//----------------------------  countSearch  ------------------------------
+// adds a finished insert or retrieve to the counters passed.  Relaxed
+// atomics, since retrieves on many threads may count at once and nothing
+// is ordered by the counts
+// Preconditions:   stats are being collected; the Probe's search is over
+// Postconditions:  none
+void BinTree::countSearch(const Probe& probe, atomic<long long>& calls,
+						  atomic<long long>& comparisons) const {
+	calls.fetch_add(1, memory_order_relaxed);
+	comparisons.fetch_add(probe.compares, memory_order_relaxed);
+	int deepest = counters->maxSearchDepth.load(memory_order_relaxed);
+	while (probe.compares > deepest &&
+		   !counters->maxSearchDepth.compare_exchange_weak(deepest,
+				probe.compares, memory_order_relaxed))
+		; //deepest now holds the other thread's depth; try again
+}
+
+//------------------------------ dumpStats --------------------------------
+// Prints getStats() as one line of JSON
+// Preconditions:   none
+// Postconditions:  none
+void BinTree::dumpStats(ostream& out) const {
+	Stats stats = getStats();
+	const char* const balances[] = {"UNBALANCED", "AVL", "SPLAY", "WEIGHTED"};
+	out << "{\"balance\":\"" << balances[balance]
+		<< "\",\"nodeCount\":" << stats.nodeCount
+		<< ",\"tombstones\":" << stats.tombstones
+		<< ",\"height\":" << stats.height
+		<< ",\"heightRatio\":" << stats.heightRatio
+		<< ",\"averageDepth\":" << stats.averageDepth
+		<< ",\"inserts\":" << stats.inserts
+		<< ",\"insertComparisons\":" << stats.insertComparisons
+		<< ",\"retrieves\":" << stats.retrieves
+		<< ",\"retrieveComparisons\":" << stats.retrieveComparisons
+		<< ",\"maxSearchDepth\":" << stats.maxSearchDepth
+		<< ",\"allocations\":" << stats.allocations
+		<< ",\"deallocations\":" << stats.deallocations
+		<< ",\"bytesInUse\":" << stats.bytesInUse
+		<< ",\"bytesReserved\":" << stats.bytesReserved
+		<< ",\"filterRejects\":" << stats.filterRejects
+		<< ",\"filterBytes\":" << stats.filterBytes
+		<< ",\"filterFalsePositiveRate\":" << stats.filterFalsePositiveRate
+		<< ",\"depthHistogram\":[";
+	for (size_t d = 0; d < stats.depthHistogram.size(); d++)
+		out << (d == 0 ? "" : ",") << stats.depthHistogram[d];
+	out << "]}" << endl;
+}
+
 //-----------------------------  ==  --------------------------------------
-// Determine if two BinTrees are equal
+// Determine if two BinTrees hold equal NodeDatas, whatever their shapes.
+// Stops at the first difference; trees that both keep hashes and hash
+// differently are told apart in O(1)
 // Preconditions:   none
 // Postconditions:  
 //       -- true is returned if all nodes in this object and rhs are equal
 //       -- false is returned if otherwise
 bool BinTree::operator==(const BinTree& rhs) const {
-	bool answer = true;
-	comparisonHelper(root, rhs.root, answer);
-	return answer;
+	return comparisonHelper(root, rhs.root, hashing && rhs.hashing);
 }
 
 //-----------------------------  !=  --------------------------------------
-// Determine if two BinTrees are not equal
+// Determine if two BinTrees do not hold equal NodeDatas, as above
 // Preconditions:   none
 // Postconditions:  
 //       -- false is returned if all nodes in this object and rhs are equal
 //       -- true is returned if otherwise
 bool BinTree::operator!=(const BinTree& rhs) const {
-	bool answer = true;
-	comparisonHelper(root, rhs.root, answer);
-	return !answer;
+	return !(*this == rhs);
 }
 
 //---------------------------  comparisonHelper  --------------------------
-// recursive helper function for the boolean operators (==, !=)
-// Preconditions:   root of this tree and root of other tree is passed
-// Postconditions:  sets bool to false if the trees are not the same
-void BinTree::comparisonHelper(Node* cur, Node* other, bool& answer) const{
-	if (cur != NULL && other != NULL) {
-			comparisonHelper(cur->left, other->left, answer);
-			if (*cur->data != *other->data)
-				answer = false;
-			comparisonHelper(cur->right, other->right, answer);
-	} else if (cur == NULL && other == NULL) {}
-	else answer = false;
+// recursive helper function for the boolean operators (==, !=).  Two
+// subtrees holding one range of keys can only hold equal NodeDatas if
+// they are the same size and, when hashed, hash the same; if their roots
+// also match, so must their left and their right subtrees.  A shared
+// subtree is equal to itself, and so is one left with only tombstones
+// to one that is empty.  Where the roots differ, or either is missing
+// or a tombstone, the subtrees are compared in order instead.  A
+// matching hash is never taken as proof.  Large subtrees are compared
+// by forkComparisonHelper
+// Preconditions:   the subtrees hold their trees' keys from one range;
+//			the bool says whether both trees keep hashes
+// Postconditions:  returns true if the subtrees hold equal NodeDatas
+bool BinTree::comparisonHelper(Node* cur, Node* other, bool hashed) const {
+	if (cur == other) //both empty, or shared
+		return true;
+	if (sizeOf(cur) != sizeOf(other))
+		return false;
+	if (sizeOf(cur) == 0) //nothing but tombstones on either side
+		return true;
+	if (hashed && hashOf(cur) != hashOf(other))
+		return false;
+	if (cur == NULL || other == NULL || cur->dead || other->dead ||
+		*cur->data != *other->data)
+		return sameInorder(cur, other);
+	if (parallelWalk(cur))
+		return forkComparisonHelper(cur, other, hashed);
+	return comparisonHelper(cur->left, other->left, hashed) &&
+		   comparisonHelper(cur->right, other->right, hashed);
+}
+
+//------------------------  forkComparisonHelper  -------------------------
+// helper for comparisonHelper; compares the left and the right subtrees
+// of two Nodes with equal keys on the pool
+// Preconditions:   as comparisonHelper; the Nodes' keys are equal
+// Postconditions:  returns true if the subtrees hold equal NodeDatas
+bool BinTree::forkComparisonHelper(Node* cur, Node* other,
+								   bool hashed) const {
+	bool left, right;
+	forkJoin([&]() {
+		left = comparisonHelper(cur->left, other->left, hashed);
+	}, [&]() {
+		right = comparisonHelper(cur->right, other->right, hashed);
+	});
+	return left && right;
+}
+
+//----------------------------  sameInorder  ------------------------------
+// compares two subtrees key by key in order, stopping at the first
+// difference; walks both with explicit stacks so it can stop mid tree,
+// passing over tombstones
+// Preconditions:   none
+// Postconditions:  returns true if they hold equal NodeDatas
+bool BinTree::sameInorder(Node* cur, Node* other) {
+	vector<Node*> curPath, otherPath;
+	for (;;) {
+		cur = nextInorder(cur, curPath);
+		other = nextInorder(other, otherPath);
+		if (cur == NULL || other == NULL)
+			return cur == NULL && other == NULL;
+		if (*cur->data != *other->data)
+			return false;
+		cur = cur->right;
+		other = other->right;
+	}
+}
+
+//------------------------------ nextInorder ------------------------------
+// helper for sameInorder; goes left from the Node passed, then takes the
+// next live Node of an in order walk off the stack, or NULL at the end
+// Preconditions:   the stack holds the Nodes the walk has yet to visit
+// Postconditions:  the Node returned has been taken off the stack
+BinTree::Node* BinTree::nextInorder(Node* cur, vector<Node*>& path) {
+	for (;;) {
+		for (; cur != NULL; cur = cur->left)
+			path.push_back(cur);
+		if (path.empty())
+			return NULL;
+		cur = path.back();
+		path.pop_back();
+		if (!cur->dead)
+			return cur;
+		cur = cur->right;
+	}
+}
+
+//-------------------------------- diff -----------------------------------
+// Lists, in order, the NodeDatas only this tree holds and those only the
+// parameter holds, skipping the subtrees the two have in common
+// Preconditions:   none
+// Postconditions:  the vectors are replaced; their NodeDatas are still
+//       owned by the trees
+void BinTree::diff(const BinTree& other, vector<NodeData*>& onlyHere,
+				   vector<NodeData*>& onlyThere) const {
+	onlyHere.clear();
+	onlyThere.clear();
+	diffHelper(root, other.root, hashing && other.hashing, onlyHere,
+			   onlyThere);
+}
+
+//-----------------------------  diffHelper  ------------------------------
+// recursive helper function for diff.  Shared subtrees, and subtrees
+// that match in size and hash when the trees are hashed, are taken to be
+// identical; with 64 bit hashes a false match is vanishingly unlikely.
+// Matching roots split both ranges the same way, so the left and the
+// right subtrees are diffed separately; otherwise both subtrees are
+// listed in order and merged
+// Preconditions:   the subtrees hold their trees' keys from one range;
+//			the bool says whether both trees keep hashes
+// Postconditions:  the differences are appended to the vectors in order
+void BinTree::diffHelper(Node* cur, Node* other, bool hashed,
+						 vector<NodeData*>& onlyHere,
+						 vector<NodeData*>& onlyThere) const {
+	if (cur == other)
+		return;
+	if (hashed && cur != NULL && other != NULL &&
+		cur->size == other->size && cur->hash == other->hash)
+		return;
+	if (cur != NULL && other != NULL && *cur->data == *other->data &&
+		cur->dead == other->dead) {
+		diffHelper(cur->left, other->left, hashed, onlyHere, onlyThere);
+		diffHelper(cur->right, other->right, hashed, onlyHere, onlyThere);
+		return;
+	}
+	vector<NodeData*> here(sizeOf(cur)), there(sizeOf(other));
+	int index = 0;
+	exportInorderHelper(here.empty() ? NULL : &here[0], cur, index,
+						sizeOf(cur));
+	index = 0;
+	exportInorderHelper(there.empty() ? NULL : &there[0], other, index,
+						sizeOf(other));
+	size_t i = 0, j = 0;
+	while (i < here.size() || j < there.size()) {
+		int order = i == here.size() ? 1 : j == there.size() ? -1 :
+					here[i]->compare(*there[j]);
+		if (order < 0)
+			onlyHere.push_back(here[i++]);
+		else if (order > 0)
+			onlyThere.push_back(there[j++]);
+		else {
+			i++;
+			j++;
+		}
+	}
 }
 
 //-----------------------------  <<  --------------------------------------
 // Overloaded output operator for class BinTree
 // Preconditions:   NodeData has a working output operator overload
-// Postconditions:  prints an in order traversal of the tree to the consol
+// Postconditions:  prints an in order traversal of the tree to the consol,
+//       in chunks through an OutputBuffer
 ostream& operator<<(ostream& out, const BinTree& toPrint) {
-	if (toPrint.root == NULL) { //if tree is empty
-		out << "Empty" << endl;
-		return out;
-	} else {
-		toPrint.inorderOstreamHelper(out, toPrint.root);
-		out << endl;
-		return out;
+	OutputBuffer buffer(out);
+	toPrint.print(buffer);
+	buffer.flush();
+	out.flush(); //as the endl this used to end with did
+	return out;
+}
+
+//------------------------------- print -----------------------------------
+// Puts an in order traversal of the tree on an OutputBuffer, as
+// operator<< prints it.  Serially the output only ever takes the
+// buffer's block; with a TaskPool each fork also holds up to
+// PRINTBUDGET bytes of the half it prints ahead, in a string
+// Preconditions:   none
+// Postconditions:  the output may still be in the buffer
+void BinTree::print(OutputBuffer& buffer) const {
+	if (size() == 0) { //if tree is empty
+		buffer.put("Empty\n", 6);
+		return;
 	}
+	inorderPrintHelper(buffer, root);
+	buffer.put('\n');
 }
 
-//------------------------  inorderOstreamHelper  -------------------------
-// helper for inorderOstreamDump; recursively puts all node data on an
-// output stream, inorder traversal
+//-------------------------  inorderPrintHelper  --------------------------
+// helper for print; recursively puts all node data on an OutputBuffer,
+// inorder traversal; large subtrees are printed by forkPrintHelper
 // Preconditions:   the root is passed as a second parameter
 // Postconditions:  none
-ostream& BinTree::inorderOstreamHelper(ostream& out, Node* cur) const {
-	if (cur != NULL) {
-		inorderOstreamHelper(out, cur->left);
-		out << " " << *cur->data;
-		inorderOstreamHelper(out, cur->right);
+void BinTree::inorderPrintHelper(OutputBuffer& buffer, Node* cur) const {
+	if (cur != NULL && parallelWalk(cur))
+		forkPrintHelper(buffer, cur);
+	else if (cur != NULL) {
+		inorderPrintHelper(buffer, cur->left);
+		if (!cur->dead) {
+			buffer.put(' ');
+			buffer.put(*cur->data);
+		}
+		inorderPrintHelper(buffer, cur->right);
+	}
+}
+
+//---------------------------  forkPrintHelper  ---------------------------
+// helper for inorderPrintHelper; prints the left half of a subtree and
+// its root straight to the buffer while a second task prints the start
+// of the right half to a string, stopping once it holds PRINTBUDGET
+// bytes.  The string then goes on the buffer, and the rest of the right
+// half is printed from where the task stopped, forking again if large,
+// so the output is the serial output and each pending fork holds at
+// most about PRINTBUDGET bytes
+// Preconditions:   the subtree is not empty
+// Postconditions:  none
+void BinTree::forkPrintHelper(OutputBuffer& buffer, Node* cur) const {
+	string right;
+	Node* next = cur->right;
+	vector<Node*> path; //Nodes the right task has yet to print
+	forkJoin([&]() {
+		inorderPrintHelper(buffer, cur->left);
+		if (!cur->dead) {
+			buffer.put(' ');
+			buffer.put(*cur->data);
+		}
+	}, [&]() {
+		printSome(right, next, path);
+	});
+	buffer.put(right.data(), right.size());
+	inorderPrintHelper(buffer, next);
+	while (!path.empty()) {
+		cur = path.back();
+		path.pop_back();
+		if (!cur->dead) {
+			buffer.put(' ');
+			buffer.put(*cur->data);
+		}
+		inorderPrintHelper(buffer, cur->right);
+	}
+}
+
+//------------------------------  printSome  ------------------------------
+// helper for forkPrintHelper; appends the live keys of an in order walk
+// to a string, as print puts them, until it holds PRINTBUDGET bytes.
+// The walk left off at the subtree passed back, then the Nodes left on
+// the stack, each followed by its right subtree
+// Preconditions:   the stack is empty or holds a walk left off earlier
+// Postconditions:  the subtree is NULL and the stack empty if the walk
+//			finished
+void BinTree::printSome(string& text, Node*& next, vector<Node*>& path) {
+	while (text.size() < PRINTBUDGET) {
+		Node* cur = nextInorder(next, path);
+		if (cur == NULL) {
+			next = NULL;
+			return;
+		}
+		text += ' ';
+		text.append(cur->data->chars(), cur->data->length());
+		next = cur->right;
 	}
-	return out;
 }
 
 //-----------------------------  >>  --------------------------------------
@@ -387,18 +2945,17 @@ ostream& BinTree::inorderOstreamHelper(ostream& out, Node* cur) const {
 // 		-- each separate string inputted (separated by whitespace) is added
 //         as a new node in BinTree
 // 		-- input "$$" to end the input stream
-// Preconditions:
-//       -- insert(NodeData*) is working
+// 		-- a token already in the tree allocates nothing, and a counting
+//         tree counts it again
+// 		-- the end of the stream ends the input too
+// Preconditions:   insertCopy is working
 // Postconditions:  All the tokens are a part of the tree
 istream& operator>>(istream& in, BinTree& rhs) {
-	string newData = "$$";
-	NodeData* newNodeData;
+	string newData;
 	for(;;) {
-		in >> newData;
-		if (newData == "$$")
+		if (!(in >> newData) || newData == "$$")
 			break;
-		newNodeData = new NodeData(newData);
-		rhs.insert(newNodeData);
+		rhs.insertCopy(NodeData(newData));
 	}
 	return in;
-}
\ No newline at end of file
+}
\ No newline at end of file
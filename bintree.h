@@ -11,7 +11,50 @@
 //				 child is larger in value.                                   //
 //                                                                       //
 // Implementation and assumptions:                                       //
-//   --     TODO                														 //
+//   -- A tree built with BinTree(BinTree::AVL) rebalances on every      //
+//      insert, keeping the height within 1.44 log2(n)                   //
+//   -- Nodes, and the NodeDatas the tree copies itself, come from an    //
+//      Arena; makeEmpty frees the tree's own Arena a slab at a time     //
+//   -- a tree built with BinTree::COPY_ON_WRITE shares its Nodes with   //
+//      its copies; a write copies the shared Nodes on its path first,   //
+//      so a copy costs O(1).  Trees sharing Nodes share one Arena too,  //
+//      locked around each allocation                                    //
+//   -- enableHashing makes every Node keep a hash of its subtree's      //
+//      contents, the sum of its keys' mixed hashes, so it does not      //
+//      depend on shape and is kept up on every write for a few adds     //
+//   -- each Node caches its key's keyPrefix, and a search compares the  //
+//      key once per level, first as integers and then with the three    //
+//      way NodeData::compare, skipping the characters the key is known  //
+//      to share with every Node left below it                           //
+//   -- save writes the tree in MappedTree's file format, keys in the    //
+//      same order as freeze                                             //
+//   -- operator<< and displaySideways format into an OutputBuffer and   //
+//      reach the stream in chunks of its block's size                   //
+//   -- enableFilter puts a blocked Bloom filter in front of retrieve;   //
+//      keys are only added to it, so removals leave stale bits that     //
+//      cost false positives until arrayToBSTree, bulkLoad or assignment //
+//      rebuild it, or it outgrows its size and is rebuilt               //
+//   -- a SPLAY tree splays top down, and a WEIGHTED tree counts hits in //
+//      padding Node already had, so neither makes a Node larger.  A     //
+//      WEIGHTED insert that goes too deep rebuilds one subtree on its   //
+//      path, as a scapegoat tree does, so no order of inserts can grow  //
+//      a linked list                                                    //
+//   -- remove unlinks a Node and rebalances its path; enableLazyRemove  //
+//      marks it a tombstone instead, in padding Node already had, and   //
+//      the tree is compacted in one linear rebuild once tombstones      //
+//      pass their share.  Sizes and hashes leave tombstones out, and    //
+//      every search and walk passes over them                           //
+//   -- enableCounting makes the tree a multiset, counting each key's    //
+//      inserts in the Node; the count takes Node from 64 to 72 bytes,   //
+//      which the Arena rounds to 80                                     //
+//   -- enableStats counts inserts, retrieves, the keys they compare     //
+//      with and allocations, in relaxed atomics; getStats adds the      //
+//      shape, and dumpStats prints it all as JSON for monitoring        //
+//   -- given a TaskPool, copying, emptying, printing and comparing      //
+//      large trees fork one task per subtree above PARALLELWALK Nodes;  //
+//      a print fork streams its left half and prints at most            //
+//      PRINTBUDGET bytes of the right half ahead into a string, so the  //
+//      output is the serial output and memory stays bounded             //
 //-----------------------------------------------------------------------//
 
 #ifndef BINTREE_H
@@ -19,7 +62,16 @@
 #include <iostream>
 #include <string.h>
 #include <algorithm>
+#include <vector>
+#include <atomic>
+#include <mutex>
 #include "nodedata.h"
+#include "arena.h"
+#include "frozentree.h"
+#include "taskpool.h"
+#include "tokenizer.h"
+#include "outputbuffer.h"
+#include "bloomfilter.h"
 using namespace std;
 
 
@@ -27,7 +79,8 @@ class BinTree {
 //-----------------------------  <<  --------------------------------------
 // Overloaded output operator for class BinTree
 // Preconditions:   NodeData has a working output operator overload
-// Postconditions:  prints an in order traversal of the tree
+// Postconditions:  prints an in order traversal of the tree, in chunks
+//       through an OutputBuffer
 friend ostream& operator<<(ostream&, const BinTree&);
 
 //-----------------------------  >>  --------------------------------------
@@ -35,12 +88,71 @@ friend ostream& operator<<(ostream&, const BinTree&);
 // 		-- each separate string inputted (separated by whitespace) is added
 //         as a new node in BinTree
 // 		-- input "$$" to end the input stream
-// Preconditions:
-//       -- insert(NodeData*) is working
+// 		-- a token already in the tree allocates nothing, and a counting
+//         tree counts it again
+// 		-- the end of the stream ends the input too
+// Preconditions:   insertCopy is working
 // Postconditions:  All the tokens are a part of the tree
 friend istream& operator>>(istream&, BinTree&);
 
 public:
+//------------------------------ Balance ----------------------------------
+// Balancing policy of a tree, fixed when the tree is constructed
+//       -- UNBALANCED: plain BST, shape depends on insertion order
+//       -- AVL: rotates on insert so sibling heights differ by at most 1
+//       -- SPLAY: moves the key of every insert, and of every retrieve
+//          through a non-const tree, to the root; amortized O(log n),
+//          and keys used often stay near the root
+//       -- WEIGHTED: inserts as UNBALANCED; every retrieve counts a hit
+//          on the Node it finds, and the tree is rebuilt by hit count
+//          (reweigh) once it has counted size() hits, at the next insert
+//          or retrieve through a non-const tree.  An insert that lands
+//          deeper than 2 log2(size()) + DEPTHSLACK rebuilds the lowest
+//          subtree on its path that is out of balance the same way, so
+//          sorted input stays O(log n) deep per insert, amortized
+enum Balance { UNBALANCED, AVL, SPLAY, WEIGHTED };
+
+//------------------------------ Copying ----------------------------------
+// What copying a tree does, fixed when the tree is constructed
+//       -- DEEP_COPY: the copy gets its own Nodes and NodeDatas
+//       -- COPY_ON_WRITE: the copy shares the Nodes, and either tree
+//          copies a shared Node only when a write reaches it
+//          (a NodeData reached through retrieve or select may then be
+//          held by copies too, so it must not be changed)
+enum Copying { DEEP_COPY, COPY_ON_WRITE };
+
+//------------------------------- Stats -----------------------------------
+// What getStats reports.  The shape is measured when it is called; the
+// counts are of the calls made since enableStats or resetStats
+struct Stats {
+	int nodeCount;              //Nodes in the tree, tombstones aside
+	int tombstones;             //Nodes removed lazily, not yet compacted
+	int height;                 //Nodes on the longest root to leaf path
+	double heightRatio;         //height over the least height possible
+	                            //for nodeCount Nodes; 1 is a complete
+	                            //tree, AVL stays under 1.44
+	double averageDepth;        //mean depth of a Node, the root being 1,
+	                            //so the comparisons of a mean hit
+	vector<int> depthHistogram; //entry d counts the Nodes at depth d + 1,
+	                            //tombstones aside
+	long long inserts;          //insert calls
+	long long insertComparisons;   //key comparisons they made
+	long long retrieves;           //retrieve calls
+	long long retrieveComparisons; //key comparisons they made
+	int maxSearchDepth;         //most comparisons one insert or retrieve
+	                            //made
+	long long allocations;      //Nodes and NodeDatas allocated one at a
+	                            //time; copies and unions are not counted
+	long long deallocations;    //Nodes and NodeDatas handed back singly
+	size_t bytesInUse;          //bytes handed out by the tree's Arena
+	size_t bytesReserved;       //bytes the Arena holds in slabs
+	long long filterRejects;    //retrieves and getDepths the filter
+	                            //answered alone
+	size_t filterBytes;         //memory the filter's bits take, 0 if
+	                            //there is no filter
+	double filterFalsePositiveRate; //expected at the keys it holds
+};
+
 //-------------------------- Constructor ----------------------------------
 // Default constructor for class BinTree
 // Preconditions:   none
@@ -48,13 +160,53 @@ public:
 //       -- a tree of size 0 is created  
 BinTree();
 
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the balancing policy of the tree
+// Preconditions:   none
+// Postconditions:  
+//       -- a tree of size 0 is created, balanced according to the policy
+explicit BinTree(Balance);
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the balancing policy and an Arena owned by the
+// caller, which may be shared by several trees
+// Preconditions:   the Arena outlives this tree
+// Postconditions:  
+//       -- a tree of size 0 is created; its Nodes come from the Arena
+BinTree(Balance, Arena&);
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the balancing policy and what copies of the tree
+// do
+// Preconditions:   none
+// Postconditions:
+//       -- a tree of size 0 is created
+BinTree(Balance, Copying);
+
+//------------------------- Bulk Constructor ------------------------------
+// Constructor accepting a batch of strings to bulk load, and the policy
+// Preconditions:   none
+// Postconditions:
+//       -- the tree holds one NodeData per distinct string, and is
+//          balanced as arrayToBSTree would build it
+BinTree(const vector<string>&, Balance);
+
 //------------------------- Copy Constructor ------------------------------
-// Constructor accepting a BinTree to be deep copied 
+// Constructor accepting a BinTree to be deep copied; a tree that copies
+// on write is copied in O(1) by sharing its root instead
 // Preconditions:  none
 // Postconditions:
 //       -- a BinTree an exact copy of the parameter is made
 BinTree(const BinTree&);
 
+//------------------------- Move Constructor ------------------------------
+// Constructor taking over the Nodes of a BinTree in O(1)
+// Preconditions:   none
+// Postconditions:
+//       -- this tree holds what the parameter held; the parameter is an
+//          empty tree with the same policies
+BinTree(BinTree&&);
+
 //--------------------------- Destructor ----------------------------------
 // Destructor for class BinTree
 // Preconditions:   none
@@ -85,6 +237,98 @@ void makeEmpty();
 //			placed in BinTree
 bool insert(NodeData*);
 
+//---------------------------- findOrInsert -------------------------------
+// Finds the NodeData equal to the parameter, inserting a copy only if
+// there is none.  The copy is made in the tree's arena once the search
+// has reached the leaf it goes in, so a key already in the tree costs
+// one search and no allocation.  A counting tree counts the key again
+// Preconditions:   none
+// Postconditions:  returns true if the copy was inserted; the second
+//			parameter points to the tree's NodeData for the key either way
+bool findOrInsert(const NodeData&, NodeData*&);
+
+//-------------------------------- count ----------------------------------
+// Returns how many times a key was inserted into a counting tree, or 1
+// if it is in a tree that does not count; 0 if it is not in the tree
+// Preconditions:   none
+// Postconditions:  none
+int count(const NodeData&) const;
+
+//--------------------------- enableCounting ------------------------------
+// Makes the tree a multiset: inserting a key it holds, through insert,
+// findOrInsert, operator>> or ingest, adds one to the key's count
+// instead of being dropped.  size() still counts distinct keys, and
+// operator== and the set operations compare keys alone; copies,
+// unionWith and bulkLoad carry the counts, while bstreeToArray, freeze
+// and save drop them
+// Preconditions:   none
+// Postconditions:  isCounting() is true, and stays true for copies
+void enableCounting();
+
+//--------------------------- disableCounting -----------------------------
+// Drops duplicates again; the counts so far are kept
+// Preconditions:   none
+// Postconditions:  isCounting() is false
+void disableCounting();
+
+//----------------------------- isCounting --------------------------------
+// Returns true if inserting a key the tree holds counts it
+// Preconditions:   none
+// Postconditions:  none
+bool isCounting() const;
+
+//------------------------------- remove ----------------------------------
+// Removes the NodeData equal to the parameter, returns true if it was in
+// the tree.  The Node is unlinked and freed, its in order successor
+// taking its place if it has two children, and the path is rebalanced
+// as insert rebalances it; a tree removing lazily marks it instead.  A
+// counting tree drops the key whatever its count
+// Preconditions:   none
+// Postconditions:  the key is no longer in the tree
+bool remove(const NodeData&);
+
+//----------------------------- removeRange -------------------------------
+// Removes every NodeData from the first parameter to the second, both
+// included, returns how many there were.  The tree is split around the
+// two keys and the outer parts joined as unionWith joins them, so it
+// costs O(log n) besides freeing the Nodes removed, copied Nodes of a
+// COPY_ON_WRITE tree included; a tree removing lazily marks them instead
+// Preconditions:   none
+// Postconditions:  no key in the range is in the tree
+int removeRange(const NodeData&, const NodeData&);
+
+//--------------------------- enableLazyRemove ----------------------------
+// Makes remove and removeRange leave tombstones: a Node removed is only
+// marked, and the sizes on its path fixed, so a burst of removals costs
+// one search each and never restructures the tree.  Searches, walks and
+// sizes pass over tombstones; inserting a key brings its tombstone back.
+// Once the tombstones are more than the share passed of the tree's
+// Nodes, the tree is compacted, so the linear rebuild is spread over
+// that many removals
+// Preconditions:   the share is in (0, 1)
+// Postconditions:  isRemovingLazily() is true, and stays true for copies
+void enableLazyRemove(double);
+
+//--------------------------- disableLazyRemove ---------------------------
+// Compacts the tree, and removes eagerly from now on
+// Preconditions:   none
+// Postconditions:  isRemovingLazily() is false; there are no tombstones
+void disableLazyRemove();
+
+//--------------------------- isRemovingLazily ----------------------------
+// Returns true if removing a key leaves a tombstone
+// Preconditions:   none
+// Postconditions:  none
+bool isRemovingLazily() const;
+
+//------------------------------- compact ---------------------------------
+// Frees the tombstones now: a WEIGHTED tree reweighs without them, any
+// other is rebuilt complete as rebalance builds it.  O(n) if there are
+// any, O(1) otherwise
+// Preconditions:   none
+// Postconditions:  same NodeDatas; no tombstones
+void compact();
+
 //---------------------------- retrieve -----------------------------------
 // Retrieve a NodeData* of a given object in the tree, return true if found
 // The second parameter will point to the actual object in the tree if 
@@ -94,6 +338,14 @@ bool insert(NodeData*);
 //       -- the second parameter points to the found object
 bool retrieve(const NodeData&, NodeData*&) const;
 
+//---------------------------- retrieve -----------------------------------
+// Retrieve, as above, through a tree that may restructure itself: a
+// SPLAY tree splays the key found, or the last Node on its path, to the
+// root, and a WEIGHTED tree reweighs if it is due
+// Preconditions:   no other thread is using the tree
+// Postconditions:  as above; the in order sequence is unchanged
+bool retrieve(const NodeData&, NodeData*&);
+
 //------------------------------ getDepth ---------------------------------
 // find the depth of a given value in the tree, return the toFind, if it is 
 //			in the tree
@@ -101,21 +353,143 @@ bool retrieve(const NodeData&, NodeData*&) const;
 // Postconditions:  none
 int getDepth(const NodeData&) const;
 
+//-------------------------------- size -----------------------------------
+// Returns the number of NodeDatas in the tree
+// Preconditions:   none
+// Postconditions:  none
+int size() const;
+
+//-------------------------------- rank -----------------------------------
+// Returns the number of NodeDatas in the tree smaller than the parameter,
+// which is the parameter's in order index if it is in the tree
+// Preconditions:   none
+// Postconditions:  none
+int rank(const NodeData&) const;
+
+//------------------------------- select ----------------------------------
+// Returns the NodeData at a given in order index, counting from 0, or
+// NULL if the index is not less than size()
+// Preconditions:   none
+// Postconditions:  the NodeData returned is still owned by the tree
+NodeData* select(int) const;
+
+//---------------------------- exportInorder ------------------------------
+// Fills an array of NodeData* by using an inorder traversal of the tree,
+// leaving the tree as it is; returns the number of entries written
+// Preconditions:   the int passed is the capacity of the array
+// Postconditions:  the first min(size(), capacity) NodeDatas are in the
+//       array, and are still owned by the tree
+int exportInorder(NodeData* [], int) const;
+
+//---------------------------- exportInorder ------------------------------
+// Replaces the contents of a vector with the NodeData* of an inorder
+// traversal of the tree, leaving the tree as it is
+// Preconditions:   none
+// Postconditions:  the vector holds size() NodeDatas, still owned by the
+//       tree
+void exportInorder(vector<NodeData*>&) const;
+
 //---------------------------- bstreeToArray ------------------------------
 // A routine fills an array of NodeData* by using an inorder traversal of
 // the tree, emptying the tree as well
-// Preconditions:   array has no more than 100 nodes
-// Postconditions:  tree is empty
+// Preconditions:   array has room for size() entries
+// Postconditions:  tree is empty; the array owns the NodeDatas
 void bstreeToArray(NodeData* []);
 
 //---------------------------- arrayToBSTree ------------------------------
 // A routine builds a balanced BinTree from a sorted array of NodeData* 
-// Preconditions:   none
+// Preconditions:   the NodeDatas in the array are followed by a NULL
 // Postconditions:  array is filled with NULLs; the root (recursively) is
 //       at (low+high)/2 where low is the lowest subscript of the array
 //       range and high is the highest
 void arrayToBSTree(NodeData* []);
 
+//---------------------------- arrayToBSTree ------------------------------
+// A routine builds a balanced BinTree from the first count entries of a
+// sorted array of NodeData*
+// Preconditions:   the int passed is the number of NodeDatas in the array
+// Postconditions:  those entries are set to NULL; the root (recursively)
+//       is at (low+high)/2 as above
+void arrayToBSTree(NodeData* [], int);
+
+//------------------------------ bulkLoad ---------------------------------
+// Replaces the contents of the tree with one NodeData per distinct string
+// in the batch.  The batch is sorted by pointer (in parallel for large
+// batches) and deduplicated before anything is allocated, then built with
+// the same midpoint construction as arrayToBSTree; O(n log n) overall.
+// A counting tree counts each string as often as the batch holds it
+// Preconditions:   none
+// Postconditions:  returns size(); the NodeDatas live in the tree's arena
+int bulkLoad(const vector<string>&);
+
+//------------------------------- ingest ----------------------------------
+// Adds a NodeData for every token of the Tokenizer's next record, as
+// operator>> would from a stream, and returns how many were new.  Tokens
+// come a batch at a time straight from the Tokenizer's block; a key is
+// only copied into the tree's arena once it is known to be new
+// Preconditions:   none
+// Postconditions:  the record and its "$$" are consumed; the tree is the
+//       one operator>> would build from the same record
+int ingest(Tokenizer&);
+
+//----------------------------- unionWith ---------------------------------
+// Adds a copy of every NodeData of the parameter this tree does not hold.
+// Built on split and join, O(m log(n/m + 1)) for trees of sizes m <= n;
+// large trees recurse on both halves at once on separate threads
+// Preconditions:   none
+// Postconditions:  this tree holds the union; the parameter is unchanged
+void unionWith(const BinTree&);
+
+//----------------------------- intersect ---------------------------------
+// Removes every NodeData the parameter does not hold; as unionWith
+// Preconditions:   none
+// Postconditions:  this tree holds the intersection; the parameter is
+//       unchanged
+void intersect(const BinTree&);
+
+//----------------------------- difference --------------------------------
+// Removes every NodeData the parameter holds; as unionWith
+// Preconditions:   none
+// Postconditions:  this tree holds the difference; the parameter is
+//       unchanged
+void difference(const BinTree&);
+
+//------------------------------- freeze ----------------------------------
+// Returns a read-only snapshot of the tree in Eytzinger order, which
+// answers retrieve, getDepth and operator<< as this tree does now
+// Preconditions:   none
+// Postconditions:  the snapshot holds copies; this tree is unchanged
+FrozenTree freeze() const;
+
+//-------------------------------- save -----------------------------------
+// Writes the tree to a file MappedTree::open maps and queries in place,
+// so a restart need not rebuild the tree; returns true if successful
+// Preconditions:   none
+// Postconditions:  the file is replaced; this tree is unchanged
+bool save(const char*) const;
+
+//------------------------------ rebalance --------------------------------
+// Rebuilds the tree into a complete tree in place, reusing its Nodes:
+// rotates it into a sorted vine, then compresses the vine back into a
+// tree (Day-Stout-Warren).  Linear time, no allocation; the tombstones
+// are freed on the way
+// Preconditions:   none
+// Postconditions:  same NodeDatas, height is floor(log2(size())) + 1
+void rebalance();
+
+//------------------------------- reweigh ---------------------------------
+// Rebuilds the tree in place so that keys retrieved often sit near the
+// root: each subtree is rooted at the key that splits its hits most
+// evenly (Mehlhorn's bisection), each Node counting one more hit than
+// it has had, so keys never retrieved still end up balanced.  The hit
+// counts are then halved, so the shape follows recent traffic.
+// O(n log n), no allocation beyond one vector of Node pointers; the
+// tombstones are freed on the way
+// Preconditions:   none
+// Postconditions:  same NodeDatas; a key with a share p of the hits is
+//       at depth O(log(1/p))
+void reweigh();
+
 //------------------------- displaySideways -------------------------------
 // Displays a binary tree as though you are viewing it from the side;
 // hard coded displaying to standard output.
@@ -123,8 +497,23 @@ void arrayToBSTree(NodeData* []);
 // Postconditions:  none
 void displaySideways() const;
 
+//------------------------- displaySideways -------------------------------
+// Displays the tree sideways, as above, to an OutputBuffer, leaving out
+// the Nodes deeper than the int unless it is 0
+// Preconditions:   none
+// Postconditions:  the output may still be in the buffer
+void displaySideways(OutputBuffer&, int) const;
+
+//------------------------------- print -----------------------------------
+// Puts an in order traversal of the tree on an OutputBuffer, as
+// operator<< prints it
+// Preconditions:   none
+// Postconditions:  the output may still be in the buffer
+void print(OutputBuffer&) const;
+
 //------------------------------  =  --------------------------------------
-// Overloaded assignment operator; current object = parameter; deep copy
+// Overloaded assignment operator; current object = parameter; deep copy,
+// or O(1) sharing if the parameter copies on write
 // Preconditions:   none
 // Postconditions:
 //       -- this tree's nodes are deallocated, and nodes containing the
@@ -132,8 +521,135 @@ void displaySideways() const;
 //			becoming an exact deep copy of the parameter
 BinTree& operator=(const BinTree&);
 
+//------------------------------  =  --------------------------------------
+// Move assignment operator; takes over the parameter's Nodes in O(1)
+// Preconditions:   none
+// Postconditions:
+//       -- this tree's nodes are deallocated, this tree holds what the
+//          parameter held, and the parameter is left empty
+BinTree& operator=(BinTree&&);
+
+//-------------------------------- swap -----------------------------------
+// Exchanges the contents and policies of two trees in O(1)
+// Preconditions:   none
+// Postconditions:  none
+void swap(BinTree&);
+
+//----------------------------- getCopying --------------------------------
+// Returns what copying this tree does
+// Preconditions:   none
+// Postconditions:  none
+Copying getCopying() const;
+
+//----------------------------- getBalance --------------------------------
+// Returns the balancing policy of this tree
+// Preconditions:   none
+// Postconditions:  none
+Balance getBalance() const;
+
+//---------------------------- setTaskPool --------------------------------
+// Makes copying, emptying, printing and comparing this tree, and its set
+// operations, fork their large subtrees onto the pool passed; NULL, the
+// default, walks whole trees on the calling thread
+// Preconditions:   the pool outlives this tree, or is unset first
+// Postconditions:  copies of the tree use the pool too; assigning to the
+//       tree keeps its own
+void setTaskPool(TaskPool*);
+
+//---------------------------- getTaskPool --------------------------------
+// Returns the pool this tree forks onto, or NULL
+// Preconditions:   none
+// Postconditions:  none
+TaskPool* getTaskPool() const;
+
+//--------------------------- enableHashing -------------------------------
+// Makes every Node keep a hash of its subtree's contents from now on, so
+// that ==, != and diff can tell most differing trees apart in O(1); the
+// hashes of the Nodes already in the tree are computed in O(n)
+// Preconditions:   none
+// Postconditions:  isHashing() is true, and stays true for copies
+void enableHashing();
+
+//----------------------------- isHashing ---------------------------------
+// Returns true if the tree keeps subtree hashes
+// Preconditions:   none
+// Postconditions:  none
+bool isHashing() const;
+
+//-------------------------------- hash -----------------------------------
+// Returns the hash of the tree's contents; trees holding equal NodeDatas
+// have equal hashes whatever their shapes
+// Preconditions:   isHashing() is true
+// Postconditions:  none
+unsigned long long hash() const;
+
+//---------------------------- enableStats --------------------------------
+// Starts counting the inserts, retrieves, key comparisons and
+// allocations this tree makes, for getStats.  Until then the only cost
+// is one test of a pointer per call
+// Preconditions:   none
+// Postconditions:  isCollectingStats() is true; copies do not count
+void enableStats();
+
+//---------------------------- disableStats -------------------------------
+// Stops counting and drops the counts
+// Preconditions:   no other thread is calling this tree
+// Postconditions:  isCollectingStats() is false
+void disableStats();
+
+//-------------------------- isCollectingStats ----------------------------
+// Returns true if the tree counts calls for getStats
+// Preconditions:   none
+// Postconditions:  none
+bool isCollectingStats() const;
+
+//----------------------------- resetStats --------------------------------
+// Sets every count back to 0, so the next getStats covers the calls from
+// now on
+// Preconditions:   none
+// Postconditions:  none
+void resetStats();
+
+//------------------------------ getStats ---------------------------------
+// Returns the tree's shape, measured in O(n), and its counts, which are 0
+// unless isCollectingStats() is true.  An insert into a tree that copies
+// on write searches first, and that search counts as a retrieve
+// Preconditions:   none
+// Postconditions:  none
+Stats getStats() const;
+
+//------------------------------ dumpStats --------------------------------
+// Prints getStats() as one line of JSON, for monitoring to parse
+// Preconditions:   none
+// Postconditions:  none
+void dumpStats(ostream&) const;
+
+//---------------------------- enableFilter -------------------------------
+// Keeps a Bloom filter of the tree's keys in front of retrieve and
+// getDepth, sized for the false positive rate passed; it takes about
+// 1.44 log2(1 / rate) + 1 bits per key, so 0.01 costs about 11.  A key
+// the filter rules out costs a hash and one cache line instead of a
+// search.  Calling it again resizes the filter for the new rate
+// Preconditions:   the rate is in (0, 1)
+// Postconditions:  isFiltering() is true, and stays true for copies
+void enableFilter(double);
+
+//---------------------------- disableFilter ------------------------------
+// Drops the filter
+// Preconditions:   none
+// Postconditions:  isFiltering() is false
+void disableFilter();
+
+//----------------------------- isFiltering -------------------------------
+// Returns true if the tree keeps a Bloom filter of its keys
+// Preconditions:   none
+// Postconditions:  none
+bool isFiltering() const;
+
 //-----------------------------  ==  --------------------------------------
-// Determine if two BinTrees are equal
+// Determine if two BinTrees hold equal NodeDatas, whatever their shapes.
+// Stops at the first difference; trees that both keep hashes and hash
+// differently are told apart in O(1)
 // Preconditions:   none
 // Postconditions:  
 //       -- true is returned if all nodes in this object and rhs are equal
@@ -141,13 +657,24 @@ BinTree& operator=(const BinTree&);
 bool operator==(const BinTree&) const;
 
 //-----------------------------  !=  --------------------------------------
-// Determine if two BinTrees are not equal
+// Determine if two BinTrees do not hold equal NodeDatas, as above
 // Preconditions:   none
 // Postconditions:  
 //       -- false is returned if all nodes in this object and rhs are equal
 //       -- true is returned if otherwise
 bool operator!=(const BinTree&) const;
 
+//-------------------------------- diff -----------------------------------
+// Lists, in order, the NodeDatas only this tree holds and those only the
+// parameter holds.  The trees are walked side by side while their keys
+// line up; subtrees the two trees share, or that match in size and hash
+// when both trees keep hashes, are skipped, and only where the shapes
+// part are the two subtrees merged key by key
+// Preconditions:   none
+// Postconditions:  the vectors are replaced; their NodeDatas are still
+//       owned by the trees
+void diff(const BinTree&, vector<NodeData*>&, vector<NodeData*>&) const;
+
 
 private:
    
@@ -155,88 +682,718 @@ struct Node {
 	NodeData* data; //pointer to data object
 	Node* left;     //left subtree pointer
 	Node* right;    //right subtree pointer
+	int height;     //height of the subtree rooted here, a leaf is 1
+	int size;       //number of Nodes in the subtree rooted here
+	bool ownsData;  //data was copied into the arena by this tree
+	bool dead;      //removed lazily; a tombstone until compacted, left
+	                //out of size and hash; fits Node's padding
+	atomic<unsigned short> hits; //retrieves that found this Node, for
+	                             //WEIGHTED trees; fits Node's padding
+	atomic<int> refs; //Node pointers to this Node, counted by trees
+	                  //that copy on write; 1 otherwise
+	int count;        //times the key was inserted, if counting; 1
+	                  //otherwise
+	unsigned long long prefix; //data->keyPrefix(), compared before data
+	unsigned long long keyHash;  //mixed data->hash(), if hashing
+	unsigned long long hash;     //sum of keyHash over the subtree
+};
+
+struct Probe {                 //a key being searched for
+	const NodeData* key;       //the key
+	unsigned long long prefix; //key->keyPrefix()
+	size_t lowCommon;          //chars shared with the last key passed on
+	                           //the right, every key below is above it
+	size_t highCommon;         //chars shared with the last key passed on
+	                           //the left, every key below is below it
+	int compares;              //keys compared with so far, for Stats
+	Node* match;               //Node an insert found or made for the key
+	bool deep;                 //a WEIGHTED insert went too deep, and no
+	                           //subtree on its path is rebuilt yet
 };
 
 Node* root;         //root of the tree
+Balance balance;    //balancing policy applied on insert
+Arena* arena;       //where Nodes are allocated from
+bool ownsArena;     //arena was created by, and is only used by, this tree
+
+struct Share {          //what trees sharing Nodes have in common
+	Arena arena;        //where their Nodes are allocated from
+	mutex lock;         //held around every use of arena
+	atomic<int> trees;  //trees using it; the last one deletes it
+};
+
+Share* share;       //NULL unless this tree copies on write
+bool hashing;       //Nodes keep keyHash and hash
+bool counting;      //inserting a key the tree holds counts it
+double removeRatio; //tombstones' share of Nodes that compacts, or 0
+                    //unless removing lazily
+int tombstones;     //Nodes marked dead and not yet freed
+TaskPool* pool;     //where whole tree walks fork, or NULL
+
+struct Counters {                        //what enableStats counts
+	atomic<long long> inserts;           //Stats fields of the same names
+	atomic<long long> insertComparisons;
+	atomic<long long> retrieves;
+	atomic<long long> retrieveComparisons;
+	atomic<int> maxSearchDepth;
+	atomic<long long> allocations;
+	atomic<long long> deallocations;
+	atomic<long long> filterRejects;
+};
+
+Counters* counters; //NULL unless stats are being collected
+BloomFilter* filter; //NULL unless enableFilter was called
 
 
+static const int PARALLELSORT = 1 << 16; //batch size worth using threads
+static const int PARALLELSET = 1 << 14;  //keys worth a thread in set ops
+static const int PARALLELWALK = 1 << 14; //Nodes worth a task in a walk
+static const size_t PRINTBUDGET = 1 << 16; //bytes a print fork holds
+static const int MAXHITS = 0xffff;       //most hits counted per Node
+static const int REWEIGHMIN = 1024;      //fewest retrieves between reweighs
+static const int DEPTHSLACK = 4;         //levels past 2 log2(n) a WEIGHTED
+                                         //insert may go
+static const int FILTERMIN = 1024;       //fewest keys a filter is sized for
+
+mutable atomic<long long> sinceReweigh; //hits counted since the last
+                                        //reweigh, WEIGHTED only
+
 //utility functions
 
 //-----------------------------  copyTree  --------------------------------
-// recursive helper function for copy constructor and assignment operator
-// Preconditions:   this tree is empty; root of this tree and root of tree
-//       to be copied is passed
-// Postconditions:  this tree is a deep copy of the root passed
-void copyTree(Node*&, Node*);
+// recursive helper function for copy constructor, assignment operator
+// and unionWith; copies a subtree of another tree with Nodes and
+// NodeDatas from the Arena passed
+// Preconditions:   the Arena is used by no other thread
+// Postconditions:  returns the copy
+Node* copyTree(Node*, Arena&) const;
+
+//---------------------------  forkCopyHelper  ----------------------------
+// helper for copyTree; copies the two subtrees of a Node on the pool, the
+// right one into an Arena of its own, adopted once it is joined
+// Preconditions:   as copyTree; the first Node is the copy of the second
+// Postconditions:  the copy's children are set
+void forkCopyHelper(Node*, Node*, Arena&) const;
 
 //---------------------------  makeEmptyHelper  ---------------------------
-// recursive helper function for the makeEmpty function
+// recursive helper function for the makeEmpty function; Nodes are only
+// handed back one at a time when the arena is shared, and subtrees other
+// trees still hold are left to them.  The bool says the arena is about
+// to be released, so no memory need be handed back at all
 // Preconditions:   root of this tree is passed
 // Postconditions:  tree is empty of all nodes, root = NULL
-void makeEmptyHelper(Node*);
+void makeEmptyHelper(Node*, bool) const;
+
+//--------------------------  forkEmptyHelper  ----------------------------
+// helper for makeEmptyHelper; empties the two subtrees of a Node on the
+// pool.  Each walk forks in a helper of its own, so that what a fork
+// needs does not weigh on every level of a deep serial walk
+// Preconditions:   as makeEmptyHelper
+// Postconditions:  the Node's subtrees are empty of all nodes
+void forkEmptyHelper(Node*, bool) const;
+
+//----------------------------  createNode  -------------------------------
+// allocates a leaf Node pointing to the NodeData passed
+// Preconditions:   none
+// Postconditions:  returns the new Node, with NULL children, height 1
+//			and size 1
+Node* createNode(NodeData*) const;
+
+//-----------------------------  allocate  --------------------------------
+// allocates memory for a Node or NodeData from the arena, locking it if
+// other trees use it
+// Preconditions:   none
+// Postconditions:  returns the memory
+void* allocate(size_t) const;
+
+//----------------------------  deallocate  -------------------------------
+// gives memory back to the arena, locking it if other trees use it
+// Preconditions:   the size is the one the memory was allocated with
+// Postconditions:  none
+void deallocate(void*, size_t) const;
+
+//-----------------------------  joinShare  -------------------------------
+// makes this tree allocate from, and share Nodes with, the trees of a
+// Share
+// Preconditions:   this tree is empty and detached
+// Postconditions:  none
+void joinShare(Share*);
+
+//------------------------------  detach  ---------------------------------
+// lets go of this tree's Arena, deleting it if no other tree uses it
+// Preconditions:   this tree is empty
+// Postconditions:  arena and share are NULL
+void detach();
+
+//-----------------------------  unshare  ---------------------------------
+// replaces a Node other trees also hold with a copy of it that only this
+// tree holds, sharing its children instead
+// Preconditions:   the Node's parent, if any, is only held by this tree
+// Postconditions:  the Node passed back is only held by this tree
+void unshare(Node*&) const;
+
+//----------------------------  unshareAll  -------------------------------
+// recursive helper for writes that touch every Node; unshares a subtree
+// from the top down
+// Preconditions:   as unshare
+// Postconditions:  no Node of the subtree is held by another tree
+void unshareAll(Node*&);
+
+//-----------------------------  initNode  --------------------------------
+// makes a leaf Node pointing to the NodeData passed in the memory passed
+// Preconditions:   the memory holds sizeof(Node) bytes
+// Postconditions:  returns the new Node, with NULL children, height 1
+//			and size 1
+Node* initNode(void*, NodeData*) const;
+
+//----------------------------  copyData  ---------------------------------
+// allocates a copy of the NodeData passed in the Arena passed, which
+// need not be this tree's
+// Preconditions:   none
+// Postconditions:  as below
+static NodeData* copyData(const NodeData&, Arena&);
+
+//----------------------------  copyData  ---------------------------------
+// allocates a copy of the NodeData passed in the arena
+// Preconditions:   none
+// Postconditions:  returns the copy; a Node pointing to it must have
+//			ownsData set so destroyData gives it back to the arena
+NodeData* copyData(const NodeData&) const;
+
+//----------------------------  copyData  ---------------------------------
+// allocates a NodeData holding the string passed in the arena
+// Preconditions:   none
+// Postconditions:  as above
+NodeData* copyData(const string&) const;
+
+//---------------------------  destroyData  -------------------------------
+// destroys the NodeData of a Node, giving its memory back to wherever it
+// was allocated from
+// Preconditions:   none
+// Postconditions:  the Node's data is NULL
+void destroyData(Node*) const;
+
+//----------------------------  freeNode  ---------------------------------
+// gives a Node's memory back to the arena
+// Preconditions:   the Node's data has been destroyed or handed off
+// Postconditions:  none
+void freeNode(Node*) const;
+
+//----------------------------  insertCopy  -------------------------------
+// inserts a copy of the NodeData passed, made in the arena only if it is
+// not already in the tree
+// Preconditions:   none
+// Postconditions:  returns true if the copy was inserted
+bool insertCopy(const NodeData&);
+
+//-----------------------------  insertKey  -------------------------------
+// inserts the NodeData passed, or a copy of the key made in the arena if
+// it is NULL, unless the key is already in the tree; then a counting
+// tree adds one to the key's count instead
+// Preconditions:   a NodeData passed is the key
+// Postconditions:  returns true if inserted; found points to the tree's
+//			NodeData for the key either way
+bool insertKey(NodeData*, const NodeData&, NodeData*& found);
+
+//----------------------------  removeHelper  -----------------------------
+// recursive helper function for remove; unlinks and frees the Node
+// holding the Probe's key, rebalancing every subtree on the way back up
+// Preconditions:   root of this tree is passed as second parameter; the
+//			tree has no tombstones
+// Postconditions:  returns true if the key was found and removed
+bool removeHelper(Probe&, Node*&);
+
+//-----------------------------  removeFirst  -----------------------------
+// recursive helper function for removeHelper; takes the Node with the
+// smallest key out of a subtree, rebalancing on the way back up
+// Preconditions:   the subtree is not empty; its parent, if any, is only
+//			held by this tree
+// Postconditions:  returns the Node taken out, only held by this tree
+Node* removeFirst(Node*&);
+
+//-----------------------------  buryHelper  ------------------------------
+// recursive helper function for remove; marks the Node holding the
+// Probe's key a tombstone, fixing the sizes and hashes on the way back up
+// Preconditions:   root of this tree is passed as second parameter
+// Postconditions:  returns true if a live Node was marked
+bool buryHelper(Probe&, Node*&);
+
+//------------------------------  buryRange  ------------------------------
+// recursive helper function for removeRange; marks every live Node of a
+// subtree from the first key to the second a tombstone, only going down
+// the sides that can hold keys in the range
+// Preconditions:   the first key is not larger than the second
+// Postconditions:  returns the number of Nodes marked
+int buryRange(Node*&, const NodeData&, const NodeData&);
+
+//----------------------------  compactIfDue  -----------------------------
+// compacts a tree that removes lazily once its tombstones are more than
+// their share of its Nodes
+// Preconditions:   none
+// Postconditions:  none
+void compactIfDue();
+
+//------------------------------  purgeVine  ------------------------------
+// unlinks the tombstones from a vine and frees them
+// Preconditions:   the pseudo root's right link holds the vine; no Node
+//			of it is held by another tree
+// Postconditions:  returns the number of Nodes freed; the tree has no
+//			tombstones
+int purgeVine(Node*);
+
+//-------------------------------  revive  --------------------------------
+// brings back the tombstone of a key being inserted again; a NodeData
+// passed replaces the one the tombstone kept
+// Preconditions:   the Node is a tombstone for the key, only held by
+//			this tree
+// Postconditions:  the Node is live, counted once; its size is not yet
+//			updated
+void revive(Node*, NodeData*);
+
+//------------------------------  findNode  -------------------------------
+// returns the Node holding the Probe's key, or NULL; a loop, so it can
+// follow the path of any tree
+// Preconditions:   none
+// Postconditions:  none
+Node* findNode(Probe&) const;
 
 //----------------------------  insertHelper  -----------------------------
 // recursive helper function for the insert function and returns true if
-// successful.  No duplicate NodeDatas are allowed
-// Preconditions:   root of this tree is passed as second and third 
-//			parameter
-// Postconditions:  NodeData is inserted into tree in correct place
-bool insertHelper(NodeData*, Node*, Node*, bool);
+// successful.  No duplicate NodeDatas are allowed.  A NULL NodeData*
+// inserts a copy of the Probe's key, made in the arena at the leaf
+// Preconditions:   root of this tree is passed as second parameter
+// Postconditions:  NodeData is inserted into tree in correct place, and
+//			every subtree on the way back up is rebalanced; the Probe's
+//			match is the Node holding the key, new or not
+bool insertHelper(NodeData*, Probe&, Node*&);
+
+//-----------------------------  makeProbe  -------------------------------
+// returns a Probe for a search from the root for the key passed
+// Preconditions:   none
+// Postconditions:  none
+static Probe makeProbe(const NodeData&);
+
+//---------------------------  compareProbe  ------------------------------
+// three way comparison of a Probe's key with a Node's; decided by the
+// prefixes when they differ, otherwise by NodeData::compare starting past
+// the characters every key in the Node's subtree shares with the Probe
+// Preconditions:   the Probe has been compared with every ancestor of the
+//			Node, in order from the root
+// Postconditions:  the Probe's common prefix lengths are updated for the
+//			child the result leads to
+static int compareProbe(Probe&, const Node*);
+
+//-----------------------------  heightOf  --------------------------------
+// returns the height of the subtree passed, 0 for an empty subtree
+// Preconditions:   none
+// Postconditions:  none
+static int heightOf(Node*);
+
+//------------------------------  sizeOf  ---------------------------------
+// returns the number of Nodes in the subtree passed
+// Preconditions:   none
+// Postconditions:  none
+static int sizeOf(Node*);
+
+//----------------------------  updateNode  -------------------------------
+// recomputes the height, size and hash of a Node from those of its
+// children; sizes and hashes leave tombstones out
+// Preconditions:   the children's heights, sizes and hashes are correct
+// Postconditions:  the Node's height, size and hash are correct
+static void updateNode(Node*);
+
+//----------------------------  rotateLeft  -------------------------------
+// rotates the subtree left; its right child becomes the subtree's root
+// Preconditions:   the subtree has a right child
+// Postconditions:  in order sequence is unchanged, heights and sizes
+//			are correct
+static void rotateLeft(Node*&);
+
+//----------------------------  rotateRight  ------------------------------
+// rotates the subtree right; its left child becomes the subtree's root
+// Preconditions:   the subtree has a left child
+// Postconditions:  in order sequence is unchanged, heights and sizes
+//			are correct
+static void rotateRight(Node*&);
+
+//-------------------------  restoreBalance  ------------------------------
+// fixes the height and size of the subtree passed and, for an AVL tree,
+// performs the single or double rotation needed to restore the AVL
+// property, unsharing the Nodes it relinks
+// Preconditions:   both children are valid subtrees under this policy;
+//			the Node passed is only held by this tree
+// Postconditions:  subtree is balanced under this tree's policy
+void restoreBalance(Node*&);
+
+//-------------------------------  splay  ---------------------------------
+// moves the Probe's key, or the last Node on its search path, to the root
+// top down (Sleator and Tarjan), unsharing the Nodes it passes.  The
+// Nodes hung on the trees of smaller and larger keys point back up their
+// spines until the end, when they are relinked and updated bottom up
+// Preconditions:   none
+// Postconditions:  returns the key's order against the root's, 0 if the
+//			root holds it; in order sequence, heights and sizes are correct
+int splay(Probe&);
+
+//-----------------------------  splayInsert  -----------------------------
+// insert for a SPLAY tree; splays the key to the root, or puts a new
+// Node for it above the Node splayed there.  A NULL NodeData* inserts a
+// copy of the Probe's key, as for insertHelper
+// Preconditions:   the tree's policy is SPLAY
+// Postconditions:  returns true if inserted; the key is at the root
+bool splayInsert(NodeData*, Probe&);
+
+//------------------------------  noteHit  --------------------------------
+// counts a retrieve that found a Node of a WEIGHTED tree
+// Preconditions:   none
+// Postconditions:  none
+void noteHit(Node*) const;
+
+//--------------------------  reweighIfDue  -------------------------------
+// reweighs a WEIGHTED tree that has had enough retrieves since the last
+// time
+// Preconditions:   no other thread is using the tree
+// Postconditions:  none
+void reweighIfDue();
+
+//----------------------------  tooDeep  ----------------------------------
+// returns true if a WEIGHTED insert that made a Node at the depth passed
+// should rebuild a subtree on its path
+// Preconditions:   none
+// Postconditions:  none
+bool tooDeep(int) const;
+
+//-------------------------  isScapegoat  ---------------------------------
+// returns true if a Node's larger child holds more than two thirds of its
+// subtree, so that rebuilding the Node's subtree shortens it
+// Preconditions:   none
+// Postconditions:  none
+static bool isScapegoat(Node*);
+
+//---------------------------  reweighSubtree  ----------------------------
+// rebuilds one subtree by hit count, as reweigh rebuilds the tree,
+// keeping its tombstones
+// Preconditions:   the Node's parent, if any, is only held by this tree
+// Postconditions:  same NodeDatas; the subtree's hits are halved
+void reweighSubtree(Node*&);
+
+//----------------------------  reweighHelper  ----------------------------
+// recursive helper function for reweigh; roots the Nodes in [low, high)
+// of the in order vector at the one whose running hit total is nearest
+// the middle of the range's, and halves its hits
+// Preconditions:   the totals are running sums of the Nodes' weights
+// Postconditions:  returns the root of the rebuilt subtree
+static Node* reweighHelper(const vector<Node*>&, const vector<long long>&,
+						   int, int);
 
 //----------------------------  retrieveHelper  ---------------------------
 // recursive helper function for the retrieve function, and a general find 
 // tool.  You have the option to have a NodeData* to the object found, or
 // a Node* to the object found, or both, by passing in NULL ptrs
-// Preconditions:   NodeData to find, NodeData to point to found, Node to
-//			point to found, and root are passed
+// Preconditions:   Probe of NodeData to find, NodeData to point to
+//			found, Node to point to found, and root are passed
 // Postconditions:  NodeDataPtr will point to found the NodeData if found,
 //			NodePtr will point to found NodeData's Node, and will return
 //			true if found
-bool retrieveHelper(const NodeData&, NodeData*&, Node*) const;
+bool retrieveHelper(Probe&, NodeData*&, Node*) const;
 
 //---------------------------  getDepthtHelper  ---------------------------
-// recursive helper function for the getDepth function.  Searches the tree
-// by inorder traversal, and keeps track of depth as it goes.  sets
-// foundDepth to the depth of the object found, if found
-// Preconditions:   the node which you want to find the depth of, the root,
-// 			the int you want the foundDepth stored in, and the root depth
-//			(1) is passed
+// recursive helper function for the getDepth function.  Follows the search
+// path for the object, keeping track of depth as it goes, and returns the
+// depth of the object found, or 0 if it is not in the tree
+// Preconditions:   a Probe of the value to find the depth of, the root,
+//			and the root depth (1) is passed
 // Postconditions:  none
-void getDepthHelper(const NodeData&, Node*, int&, int) const;
+int getDepthHelper(Probe&, Node*, int) const;
+
+//------------------------  exportInorderHelper  --------------------------
+// recursive helper function for exportInorder; fills an array of NodeData*
+// by an inorder traversal, stopping once the capacity is reached
+// Preconditions:   the index starts at 0, the last int is the capacity
+// Postconditions:  index is the number of entries written
+void exportInorderHelper(NodeData*[], Node*, int&, int) const;
 
 //------------------------  bstreeToArrayHelper  --------------------------
 // recursive helper function for bstreeToArray; fills an array of NodeData*
 // by using an inorder traversal of the tree, emptying the tree as well
-// Preconditions:   array has no less than 100 nodes
+// Preconditions:   array has room for every node
 // Postconditions:  tree is empty
 void bstreeToArrayHelper(NodeData*[], Node*, int&);
 
-//------------------------  bstreeToArrayHelper  --------------------------
-// recursive helper function for arrayToBSTree; fills a tree with NodeData*
-// by inputting a NodeData*[], emptying the array as well
-// Preconditions:   array has no less than 100 nodes
-// Postconditions:  array is all NULL
-void arrayToBSTreeHelper(NodeData*[], Node*&, int, int);
+//------------------------  arrayToBSTreeHelper  --------------------------
+// recursive helper function for arrayToBSTree and bulkLoad; fills a tree
+// with the NodeData* in [low, high) of a sorted array, rooting every
+// subtree at the midpoint of its range
+// Preconditions:   the bool says whether the NodeDatas live in the arena
+// Postconditions:  the subtree holds every NodeData in the range
+void arrayToBSTreeHelper(NodeData*[], Node*&, int, int, bool);
+
+//----------------------------  sortBatch  --------------------------------
+// sorts pointers to strings by the strings they point to; batches of at
+// least PARALLELSORT strings are sorted in chunks on separate threads and
+// merged pairwise, also in parallel
+// Preconditions:   none
+// Postconditions:  the pointers are in ascending order of string
+static void sortBatch(vector<const string*>&);
+
+//----------------------------  freezeHelper  -----------------------------
+// recursive helper function for freeze and save; collects the NodeDatas
+// in order along with the depth of each
+// Preconditions:   the root and the root depth (1) are passed
+// Postconditions:  both vectors have one more entry per Node
+void freezeHelper(Node*, int, vector<NodeData*>&, vector<int>&) const;
+
+//----------------------------  treeToVine  -------------------------------
+// rotates right until no Node has a left child, turning the tree hanging
+// off the pseudo root's right link into a sorted list along right links
+// Preconditions:   the pseudo root's right link holds the tree
+// Postconditions:  returns the number of Nodes in the vine
+static int treeToVine(Node*);
+
+//----------------------------  compressVine  -----------------------------
+// one Day-Stout-Warren pass: rotates left at every other Node down the
+// vine, for the number of rotations passed
+// Preconditions:   the pseudo root's right link holds the vine
+// Postconditions:  the vine is about half as long
+static void compressVine(Node*, int);
+
+//----------------------------  vineToTree  -------------------------------
+// compresses a sorted vine of the given length into a complete tree; the
+// first pass only rotates the Nodes that end up on the bottom level
+// Preconditions:   the pseudo root's right link holds the vine
+// Postconditions:  the pseudo root's right link holds a complete tree;
+//			heights and sizes are not yet updated
+static void vineToTree(Node*, int);
+
+//----------------------------  updateSubtree  ----------------------------
+// recomputes the height, size and hash of every Node in a subtree, bottom
+// up
+// Preconditions:   none
+// Postconditions:  every height, size and hash in the subtree is correct
+static void updateSubtree(Node*);
 
 //-----------------------------  sideways  --------------------------------
 // recursive helper function for display sideways
-// Preconditions:   root is passed, with level 0
+// Preconditions:   root is passed, with level 0, and the depth limit
 // Postconditions:  none
-void sideways(Node*, int) const;
+void sideways(OutputBuffer&, Node*, int, int) const;
 
 //---------------------------  comparisonHelper  --------------------------
-// recursive helper function for the boolean operators (==, !=)
-// Preconditions:   root of this tree and root of other tree is passed
-// Postconditions:  sets bool to false if the trees are not the same
-void comparisonHelper(Node*, Node*, bool&) const;
-
-//------------------------  inorderOstreamHelper  -------------------------
-// helper for inorderOstreamDump; recursively puts all node data on an
-// output stream, inorder traversal
+// recursive helper function for the boolean operators (==, !=); walks
+// both trees side by side while their keys line up, and compares the
+// rest in order where they do not
+// Preconditions:   the subtrees hold their trees' keys from one range
+// Postconditions:  returns true if the subtrees hold equal NodeDatas
+bool comparisonHelper(Node*, Node*, bool) const;
+
+//------------------------  forkComparisonHelper  -------------------------
+// helper for comparisonHelper; compares the left and the right subtrees
+// of two Nodes with equal keys on the pool
+// Preconditions:   as comparisonHelper; the Nodes' keys are equal
+// Postconditions:  returns true if the subtrees hold equal NodeDatas
+bool forkComparisonHelper(Node*, Node*, bool) const;
+
+//----------------------------  sameInorder  ------------------------------
+// compares two subtrees key by key in order, stopping at the first
+// difference, passing over tombstones
+// Preconditions:   none
+// Postconditions:  returns true if they hold equal NodeDatas
+static bool sameInorder(Node*, Node*);
+
+//------------------------------ nextInorder ------------------------------
+// helper for sameInorder; goes left from the Node passed, then takes the
+// next live Node of an in order walk off the stack, or NULL at the end
+// Preconditions:   the stack holds the Nodes the walk has yet to visit
+// Postconditions:  the Node returned has been taken off the stack
+static Node* nextInorder(Node*, vector<Node*>&);
+
+//-----------------------------  diffHelper  ------------------------------
+// recursive helper function for diff; as comparisonHelper, appending the
+// differences instead of stopping at them
+// Preconditions:   the subtrees hold their trees' keys from one range
+// Postconditions:  the differences are appended to the vectors in order
+void diffHelper(Node*, Node*, bool, vector<NodeData*>&,
+				vector<NodeData*>&) const;
+
+//-------------------------------  split  ---------------------------------
+// splits a subtree around a key into the subtree of smaller keys, the
+// Node holding the key if there is one, and the subtree of larger keys;
+// the Nodes it relinks are unshared first
+// Preconditions:   the subtree's parent, if any, is only held by this
+//			tree, and no longer points to it
+// Postconditions:  the Nodes are reused; the found Node has no children
+void split(Node*, const NodeData&, Node*&, Node*&, Node*&) const;
+
+//--------------------------------  join  ---------------------------------
+// joins two AVL subtrees and a Node whose key lies between them into one
+// AVL subtree, in time proportional to the difference of their heights;
+// the Nodes it relinks are unshared first
+// Preconditions:   every key of the first subtree is smaller than the
+//			Node's, and every key of the second larger; the Node
+//			and the subtrees' roots are held by nothing else in
+//			this tree
+// Postconditions:  returns the root of the joined subtree
+Node* join(Node*, Node*, Node*) const;
+
+//-----------------------------  joinRight  -------------------------------
+// join, for a first subtree more than one taller than the second; walks
+// down its right spine to a subtree short enough to hang the rest on
+// Preconditions:   as join
+// Postconditions:  as join
+Node* joinRight(Node*, Node*, Node*) const;
+
+//-----------------------------  joinLeft  --------------------------------
+// join, for a second subtree more than one taller than the first
+// Preconditions:   as join
+// Postconditions:  as join
+Node* joinLeft(Node*, Node*, Node*) const;
+
+//------------------------------  joinTwo  --------------------------------
+// joins two AVL subtrees with no Node between them
+// Preconditions:   as join
+// Postconditions:  returns the root of the joined subtree
+Node* joinTwo(Node*, Node*) const;
+
+//-----------------------------  splitLast  -------------------------------
+// takes the Node with the largest key out of a subtree
+// Preconditions:   the subtree is not empty; as join
+// Postconditions:  returns the rest of the subtree; the Node taken out
+//			is passed back in the second parameter
+Node* splitLast(Node*, Node*&) const;
+
+//----------------------------  forkLevels  -------------------------------
+// returns how many levels of a recursion should fork, so that every core
+// gets work
+// Preconditions:   none
+// Postconditions:  none
+int forkLevels() const;
+
+//------------------------------  forkJoin  -------------------------------
+// runs two tasks at once and returns when both are done: on the tree's
+// pool if it has one, else the second on a thread of its own
+// Preconditions:   the tasks do not depend on each other
+// Postconditions:  both tasks have run
+void forkJoin(const function<void()>&, const function<void()>&) const;
+
+//----------------------------  parallelWalk  -----------------------------
+// returns true if a whole tree walk should fork at the subtree passed
+// Preconditions:   none
+// Postconditions:  none
+bool parallelWalk(Node*) const;
+
+//----------------------------  unionHelper  ------------------------------
+// recursive helper for unionWith; splits this tree's subtree around the
+// other subtree's root key and unions the halves, on two threads while
+// forks remain and the subtrees are large
+// Preconditions:   new Nodes come from the Arena passed, used by no
+//			other thread
+// Postconditions:  returns the root of the union
+Node* unionHelper(Node*, Node*, Arena&, int) const;
+
+//---------------------------  intersectHelper  ---------------------------
+// recursive helper for intersect; as unionHelper, handing the subtrees
+// it drops to the vector to be freed once every thread is done
+// Preconditions:   the vector is used by no other thread
+// Postconditions:  returns the root of the intersection
+Node* intersectHelper(Node*, Node*, vector<Node*>&, int) const;
+
+//--------------------------  differenceHelper  ---------------------------
+// recursive helper for difference; as intersectHelper
+// Preconditions:   the vector is used by no other thread
+// Postconditions:  returns the root of the difference
+Node* differenceHelper(Node*, Node*, vector<Node*>&, int) const;
+
+//------------------------------  mixHash  --------------------------------
+// scrambles a NodeData::hash so that sums of them rarely collide
+// Preconditions:   none
+// Postconditions:  none
+static unsigned long long mixHash(size_t);
+
+//-----------------------------  hashHelper  ------------------------------
+// recursive helper function for enableHashing; computes every keyHash
+// and hash of a subtree
+// Preconditions:   none
+// Postconditions:  the subtree's hashes are correct
+static void hashHelper(Node*);
+
+//-------------------------------  hashOf  --------------------------------
+// returns the hash of the subtree passed, 0 for an empty subtree
+// Preconditions:   none
+// Postconditions:  none
+static unsigned long long hashOf(Node*);
+
+//----------------------------  filteredOut  ------------------------------
+// returns true if the tree's filter rules out the key passed
+// Preconditions:   none
+// Postconditions:  none
+bool filteredOut(const NodeData&) const;
+
+//----------------------------  addToFilter  ------------------------------
+// adds a key just inserted to the filter, rebuilding it larger instead
+// once it holds as many keys as it was sized for
+// Preconditions:   the tree has a filter and holds the key
+// Postconditions:  none
+void addToFilter(const NodeData&);
+
+//---------------------------  rebuildFilter  -----------------------------
+// replaces the filter with one sized for twice the tree's keys at the
+// same rate, and adds them all
+// Preconditions:   the tree has a filter
+// Postconditions:  none
+void rebuildFilter();
+
+//----------------------------  filterHelper  -----------------------------
+// recursive helper function for rebuildFilter and unionWith; adds the
+// keys of a subtree to the filter
+// Preconditions:   the tree has a filter
+// Postconditions:  none
+void filterHelper(Node*);
+
+//----------------------------  countSearch  ------------------------------
+// adds a finished insert or retrieve to the counters passed, which are
+// the inserts' or the retrieves' ones
+// Preconditions:   stats are being collected; the Probe's search is over
+// Postconditions:  none
+void countSearch(const Probe&, atomic<long long>&,
+				 atomic<long long>&) const;
+
+//-----------------------------  statsHelper  -----------------------------
+// helper function for getStats; counts the Nodes of a subtree by depth
+// and adds up their depths, without recursing
+// Preconditions:   none
+// Postconditions:  the histogram has an entry for every depth reached
+static void statsHelper(Node*, vector<int>&, long long&);
+
+//-------------------------  inorderPrintHelper  --------------------------
+// helper for print; recursively puts all node data on an OutputBuffer,
+// inorder traversal
 // Preconditions:   the root is passed as a second parameter
 // Postconditions:  none
-ostream& inorderOstreamHelper(ostream&, Node*) const;
+void inorderPrintHelper(OutputBuffer&, Node*) const;
+
+//---------------------------  forkPrintHelper  ---------------------------
+// helper for inorderPrintHelper; prints the left half of a subtree to
+// the buffer while a task prints up to PRINTBUDGET bytes of the right
+// half ahead into a string, then prints the rest of the right half
+// Preconditions:   the subtree is not empty
+// Postconditions:  none
+void forkPrintHelper(OutputBuffer&, Node*) const;
+
+//------------------------------  printSome  ------------------------------
+// helper for forkPrintHelper; appends the live keys of an in order walk
+// to a string until it holds PRINTBUDGET bytes, leaving the walk's
+// subtree and stack where it stopped
+// Preconditions:   the stack is empty or holds a walk left off earlier
+// Postconditions:  the subtree is NULL and the stack empty if the walk
+//			finished
+static void printSome(string&, Node*&, vector<Node*>&);
 
 };
 
+//-------------------------------- swap -----------------------------------
+// Exchanges the contents and policies of two trees in O(1)
+// Preconditions:   none
+// Postconditions:  none
+void swap(BinTree&, BinTree&);
+
 #endif
@@ -0,0 +1,71 @@
+//-----------------------------------------------------------------------//
+// BINTREETEST.CPP                                                       //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// Regression checks for BinTree, for cases lab2's data does not reach   //
+//-----------------------------------------------------------------------//
+// Usage:  bintreetest                                                   //
+//                                                                       //
+// Output:  one line per check failed; the exit status is the number of  //
+//       checks failed, so 0 when all pass                               //
+//                                                                       //
+// Checks:                                                               //
+//   -- lazyCompare:  a tree whose lazy removal leaves a subtree holding //
+//      only tombstones compares equal to a tree without that subtree,   //
+//      from either side                                                 //
+//-----------------------------------------------------------------------//
+
+#include "bintree.h"
+#include <iostream>
+using namespace std;
+
+//global function prototypes
+bool lazyCompare();
+void buildKeys(BinTree&, const string&);
+
+//-------------------------------- main -----------------------------------
+// runs every check and reports the ones that fail
+int main() {
+	struct Check {
+		const char* name;
+		bool (*run)();
+	};
+	const Check checks[] = {{"lazyCompare", lazyCompare}};
+	int failed = 0;
+	for (size_t i = 0; i < sizeof(checks) / sizeof(checks[0]); i++) {
+		if (!checks[i].run()) {
+			cout << "FAILED " << checks[i].name << endl;
+			failed++;
+		}
+	}
+	return failed;
+}
+
+//----------------------------- lazyCompare -------------------------------
+// {d,f,e,g} against {d,b,f,e,g} with b removed lazily: b's subtree is
+// left holding a tombstone only, where the other tree has no subtree
+// Preconditions:   none
+// Postconditions:  returns true if the trees compare equal both ways
+bool lazyCompare() {
+	BinTree a, b;
+	buildKeys(a, "dfeg");
+	buildKeys(b, "dbfeg");
+	b.enableLazyRemove(0.9);
+	if (!b.remove(NodeData("b")))
+		return false;
+	return a == b && b == a && !(a != b);
+}
+
+//------------------------------ buildKeys --------------------------------
+// inserts each character of the string into the tree as a one letter
+// key, in order
+// Preconditions:   none
+// Postconditions:  none
+void buildKeys(BinTree& tree, const string& letters) {
+	for (size_t i = 0; i < letters.size(); i++) {
+		NodeData* found;
+		tree.findOrInsert(NodeData(string(1, letters[i])), found);
+	}
+}
@@ -0,0 +1,126 @@
+//-----------------------------------------------------------------------//
+// BLOOMFILTER.CPP                                                       //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// BloomFilter answers "might this key be in the set?" in a few bit      //
+// tests, never wrongly answering no                                     //
+//-----------------------------------------------------------------------//
+// Implementation and assumptions:                                       //
+//   -- a key's block comes from the high 32 bits of its hash, and its   //
+//      bits within the block by double hashing: the i-th bit is         //
+//      (low + i * step) mod BLOCKBITS, low being the low 32 bits and    //
+//      step the high 32 of the hash times MULTIPLIER, made odd so the   //
+//      bits differ                                                      //
+//-----------------------------------------------------------------------//
+
+#include "bloomfilter.h"
+#include <cmath>
+#include <algorithm>
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the number of keys to size the filter for and
+// the false positive rate wanted at that many keys.  The best number of
+// bits per key is log2(1 / rate) / ln 2, each key setting ln 2 times as
+// many bits; blocking adds BLOCKINGBITS to keep to the rate
+// Preconditions:   the int is positive; the rate is in (0, 1)
+// Postconditions:
+//       -- an empty filter is created
+BloomFilter::BloomFilter(int expected, double wanted) {
+	double bitsPerKey = log2(1 / wanted) / log(2.0) + BLOCKINGBITS;
+	double total = max(1, expected) * bitsPerKey;
+	blocks = max((size_t)1, (size_t)ceil(total / BLOCKBITS));
+	probes = max(1, min(16, (int)round(bitsPerKey * log(2.0))));
+	bits.assign(blocks, Block());
+	keys = 0;
+	sizedFor = expected;
+	sizedRate = wanted;
+}
+
+//-------------------------------- add ------------------------------------
+// Adds a key's hash to the filter
+// Preconditions:   none
+// Postconditions:  mayContain is true for the hash from now on
+void BloomFilter::add(unsigned long long hash) {
+	unsigned long long* block = bits[blockOf(hash)].words;
+	unsigned int bit = (unsigned int)hash;
+	unsigned int step = (unsigned int)((hash * MULTIPLIER) >> 32) | 1;
+	for (int i = 0; i < probes; i++, bit += step)
+		block[(bit % BLOCKBITS) / 64] |= 1ULL << (bit % 64);
+	keys++;
+}
+
+//----------------------------- mayContain --------------------------------
+// Returns false if a key's hash was certainly never added, true if it
+// probably was
+// Preconditions:   none
+// Postconditions:  none
+bool BloomFilter::mayContain(unsigned long long hash) const {
+	const unsigned long long* block = bits[blockOf(hash)].words;
+	unsigned int bit = (unsigned int)hash;
+	unsigned int step = (unsigned int)((hash * MULTIPLIER) >> 32) | 1;
+	for (int i = 0; i < probes; i++, bit += step)
+		if ((block[(bit % BLOCKBITS) / 64] & (1ULL << (bit % 64))) == 0)
+			return false;
+	return true;
+}
+
+//------------------------------- clear -----------------------------------
+// Empties the filter, keeping its size
+// Preconditions:   none
+// Postconditions:  count() is 0
+void BloomFilter::clear() {
+	fill(bits.begin(), bits.end(), Block());
+	keys = 0;
+}
+
+//------------------------------- count -----------------------------------
+// Returns the number of adds since the filter was built or cleared
+// Preconditions:   none
+// Postconditions:  none
+int BloomFilter::count() const {
+	return keys;
+}
+
+//------------------------------ capacity ---------------------------------
+// Returns the number of keys the filter was sized for
+// Preconditions:   none
+// Postconditions:  none
+int BloomFilter::capacity() const {
+	return sizedFor;
+}
+
+//-------------------------------- rate -----------------------------------
+// Returns the false positive rate the filter was sized for
+// Preconditions:   none
+// Postconditions:  none
+double BloomFilter::rate() const {
+	return sizedRate;
+}
+
+//-------------------------------- bytes ----------------------------------
+// Returns the memory the bits take
+// Preconditions:   none
+// Postconditions:  none
+size_t BloomFilter::bytes() const {
+	return bits.size() * sizeof(Block);
+}
+
+//------------------------- falsePositiveRate -----------------------------
+// Returns the false positive rate expected for the keys added so far
+// Preconditions:   none
+// Postconditions:  none
+double BloomFilter::falsePositiveRate() const {
+	double filled = 1 - exp(-(double)probes * keys /
+							((double)blocks * BLOCKBITS));
+	return pow(filled, probes);
+}
+
+//------------------------------  blockOf  --------------------------------
+// returns the index of the block a hash's bits fall in
+// Preconditions:   none
+// Postconditions:  none
+size_t BloomFilter::blockOf(unsigned long long hash) const {
+	return (size_t)(((hash >> 32) * blocks) >> 32);
+}
@@ -0,0 +1,125 @@
+//-----------------------------------------------------------------------//
+// BLOOMFILTER.H                                                         //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// BloomFilter answers "might this key be in the set?" in a few bit      //
+// tests, never wrongly answering no                                     //
+//-----------------------------------------------------------------------//
+// Bloom filter:  every key added sets a few bits picked by its hash; a  //
+//       key any of whose bits is clear was never added.  A key all of   //
+//       whose bits are set was probably added, and is a false positive  //
+//       otherwise.                                                      //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- blocked: all of a key's bits fall in one 64 byte block, aligned  //
+//      to 64 bytes, so a test touches one cache line.  Blocks fill      //
+//      unevenly, which costs some accuracy; one more bit per key makes  //
+//      up for it                                                        //
+//   -- the filter is sized for a capacity and a false positive rate:    //
+//      about 1.44 log2(1 / rate) + 1 bits per key, rounded up to blocks.//
+//      Past the capacity the rate climbs, so the owner rebuilds it      //
+//   -- keys are passed as 64 bit hashes that are already well mixed;    //
+//      the filter only slices them up                                   //
+//   -- keys cannot be taken out; clear empties the whole filter         //
+//-----------------------------------------------------------------------//
+
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+#include <vector>
+#include <cstddef>
+using namespace std;
+
+
+class BloomFilter {
+public:
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the number of keys to size the filter for and
+// the false positive rate wanted at that many keys
+// Preconditions:   the int is positive; the rate is in (0, 1)
+// Postconditions:
+//       -- an empty filter is created
+BloomFilter(int, double);
+
+//-------------------------------- add ------------------------------------
+// Adds a key's hash to the filter
+// Preconditions:   none
+// Postconditions:  mayContain is true for the hash from now on
+void add(unsigned long long);
+
+//----------------------------- mayContain --------------------------------
+// Returns false if a key's hash was certainly never added, true if it
+// probably was
+// Preconditions:   none
+// Postconditions:  none
+bool mayContain(unsigned long long) const;
+
+//------------------------------- clear -----------------------------------
+// Empties the filter, keeping its size
+// Preconditions:   none
+// Postconditions:  count() is 0
+void clear();
+
+//------------------------------- count -----------------------------------
+// Returns the number of adds since the filter was built or cleared
+// Preconditions:   none
+// Postconditions:  none
+int count() const;
+
+//------------------------------ capacity ---------------------------------
+// Returns the number of keys the filter was sized for
+// Preconditions:   none
+// Postconditions:  none
+int capacity() const;
+
+//-------------------------------- rate -----------------------------------
+// Returns the false positive rate the filter was sized for
+// Preconditions:   none
+// Postconditions:  none
+double rate() const;
+
+//-------------------------------- bytes ----------------------------------
+// Returns the memory the bits take
+// Preconditions:   none
+// Postconditions:  none
+size_t bytes() const;
+
+//------------------------- falsePositiveRate -----------------------------
+// Returns the false positive rate expected for the keys added so far,
+// (1 - e^(-k n / m))^k for k bits per key, n adds and m bits; that is
+// the rate of an unblocked filter, a little under this one's
+// Preconditions:   none
+// Postconditions:  none
+double falsePositiveRate() const;
+
+private:
+static const int BLOCKWORDS = 8;               //words in a block
+static const int BLOCKBITS = BLOCKWORDS * 64;  //bits in a block
+static const int BLOCKINGBITS = 1;             //bits per key added to make
+                                               //up for blocking
+static const unsigned long long MULTIPLIER = 0x9e3779b97f4a7c15ULL;
+                                               //remixes a hash for step
+
+struct Block {                   //one cache line of bits
+	alignas(64) unsigned long long words[BLOCKWORDS];
+};
+
+vector<Block> bits;              //the blocks, each on a line of its own
+size_t blocks;                   //blocks in bits
+int probes;                      //bits set per key
+int keys;                        //adds since built or cleared
+int sizedFor;                    //capacity
+double sizedRate;                //rate
+
+//------------------------------  blockOf  --------------------------------
+// returns the index of the block a hash's bits fall in; the high half
+// of the hash is scaled onto the blocks, so their number need not be a
+// power of 2
+// Preconditions:   none
+// Postconditions:  none
+size_t blockOf(unsigned long long) const;
+
+};
+
+#endif
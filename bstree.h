@@ -0,0 +1,640 @@
+//-----------------------------------------------------------------------//
+// BSTREE.H                                                              //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// BSTree is a generic AVL tree storing its keys inside its nodes        //
+//-----------------------------------------------------------------------//
+// Binary Search Tree:  defined as a tree in which every node has at most//
+//       two children.  Left child is smaller in value, right child is   //
+//       larger in value.                                                //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- BSTree<Key, Compare, Allocator>: Key is copied into the node, so //
+//      a lookup follows one pointer per level instead of two            //
+//   -- Compare is a strict weak ordering taken as a template argument,  //
+//      so the comparisons are calls the compiler can inline             //
+//   -- Allocator is rebound to allocate whole nodes                     //
+//   -- always AVL balanced; the interface follows BinTree, except that  //
+//      insert copies the key rather than taking ownership of a pointer  //
+//   -- NodeDataTree is the instantiation for NodeData keys              //
+//   -- templates, so everything is defined in this header               //
+//-----------------------------------------------------------------------//
+
+#ifndef BSTREE_H
+#define BSTREE_H
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include "nodedata.h"
+using namespace std;
+
+
+template <class Key, class Compare = less<Key>,
+		  class Allocator = allocator<Key> >
+class BSTree {
+//-----------------------------  <<  --------------------------------------
+// Overloaded output operator for class BSTree
+// Preconditions:   Key has a working output operator overload
+// Postconditions:  prints an in order traversal of the tree
+friend ostream& operator<<(ostream& out, const BSTree& toPrint) {
+	if (toPrint.root == NULL) { //if tree is empty
+		out << "Empty" << endl;
+		return out;
+	} else {
+		toPrint.inorderOstreamHelper(out, toPrint.root);
+		out << endl;
+		return out;
+	}
+}
+
+public:
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the comparison and allocator objects to use
+// Preconditions:   none
+// Postconditions:
+//       -- a tree of size 0 is created
+explicit BSTree(const Compare& = Compare(), const Allocator& = Allocator());
+
+//------------------------- Copy Constructor ------------------------------
+// Constructor accepting a BSTree to be deep copied
+// Preconditions:  none
+// Postconditions:
+//       -- a BSTree an exact copy of the parameter is made
+BSTree(const BSTree&);
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class BSTree
+// Preconditions:   none
+// Postconditions:
+//       -- all nodes are deallocated
+~BSTree();
+
+//----------------------------- isEmpty -----------------------------------
+// Returns true if tree is empty
+// Preconditions:   none
+// Postconditions:  none
+bool isEmpty() const;
+
+//---------------------------- makeEmpty ----------------------------------
+// Deallocate all nodes
+// Preconditions:   none
+// Postconditions:
+//       -- no nodes in BSTree, root = NULL
+void makeEmpty();
+
+//------------------------------ insert -----------------------------------
+// Add a copy of a key to the tree, returns true if successful.  No
+// duplicate keys are allowed
+// Preconditions:   none
+// Postconditions:
+//       -- the key is in a new node placed and balanced in the tree
+bool insert(const Key&);
+
+//---------------------------- retrieve -----------------------------------
+// Retrieve a pointer to the tree's copy of a key, return true if found
+// Preconditions:   none
+// Postconditions:
+//       -- the second parameter points to the found key.  If key is not
+//          found, no reassignment of ptr is made
+bool retrieve(const Key&, const Key*&) const;
+
+//------------------------------ getDepth ---------------------------------
+// Returns the depth of a key in the tree, the root being 1, or 0 if it is
+// not in the tree
+// Preconditions:   none
+// Postconditions:  none
+int getDepth(const Key&) const;
+
+//-------------------------------- size -----------------------------------
+// Returns the number of keys in the tree
+// Preconditions:   none
+// Postconditions:  none
+int size() const;
+
+//------------------------- displaySideways -------------------------------
+// Displays a binary tree as though you are viewing it from the side;
+// hard coded displaying to standard output.
+// Preconditions:   none
+// Postconditions:  none
+void displaySideways() const;
+
+//------------------------------  =  --------------------------------------
+// Overloaded assignment operator; current object = parameter; deep copy
+// Preconditions:   none
+// Postconditions:
+//       -- this tree's nodes are deallocated, and this tree becomes an
+//          exact deep copy of the parameter
+BSTree& operator=(const BSTree&);
+
+//-----------------------------  ==  --------------------------------------
+// Determine if two BSTrees have the same shape and keys; unlike BinTree,
+// equal keys in different shapes compare unequal
+// Preconditions:   none
+// Postconditions:  none
+bool operator==(const BSTree&) const;
+
+//-----------------------------  !=  --------------------------------------
+// Determine if two BSTrees differ in shape or keys
+// Preconditions:   none
+// Postconditions:  none
+bool operator!=(const BSTree&) const;
+
+private:
+struct Node {
+	Key key;        //the key itself, not a pointer to it
+	Node* left;     //left subtree pointer
+	Node* right;    //right subtree pointer
+	int height;     //height of the subtree rooted here, a leaf is 1
+	int size;       //number of Nodes in the subtree rooted here
+
+	explicit Node(const Key& toCopy)
+		: key(toCopy), left(NULL), right(NULL), height(1), size(1) {}
+};
+
+typedef typename allocator_traits<Allocator>::template
+	rebind_alloc<Node> NodeAllocator;
+typedef allocator_traits<NodeAllocator> NodeTraits;
+
+Node* root;             //root of the tree
+Compare lessThan;       //orders the keys
+NodeAllocator nodeAlloc; //allocates the nodes
+
+//utility functions
+
+//----------------------------  createNode  -------------------------------
+// allocates and constructs a leaf holding a copy of the key
+// Preconditions:   none
+// Postconditions:  returns the new node
+Node* createNode(const Key&);
+
+//----------------------------  destroyNode  ------------------------------
+// destroys and deallocates a node
+// Preconditions:   none
+// Postconditions:  none
+void destroyNode(Node*);
+
+//-----------------------------  copyTree  --------------------------------
+// recursive helper function for copy constructor and assignment operator
+// Preconditions:   none
+// Postconditions:  returns a deep copy of the subtree passed
+Node* copyTree(const Node*);
+
+//---------------------------  makeEmptyHelper  ---------------------------
+// recursive helper function for the makeEmpty function
+// Preconditions:   none
+// Postconditions:  every node in the subtree is deallocated
+void makeEmptyHelper(Node*);
+
+//----------------------------  insertHelper  -----------------------------
+// recursive helper function for the insert function; rebalances every
+// subtree on the way back up
+// Preconditions:   root of this tree is passed as second parameter
+// Postconditions:  returns true if the key was inserted
+bool insertHelper(const Key&, Node*&);
+
+//-----------------------------  findNode  --------------------------------
+// returns the node holding a key and sets the int to its depth, or
+// returns NULL
+// Preconditions:   none
+// Postconditions:  none
+const Node* findNode(const Key&, int&) const;
+
+//-----------------------------  heightOf  --------------------------------
+// returns the height of the subtree passed, 0 for an empty subtree
+// Preconditions:   none
+// Postconditions:  none
+static int heightOf(const Node*);
+
+//------------------------------  sizeOf  ---------------------------------
+// returns the number of nodes in the subtree passed
+// Preconditions:   none
+// Postconditions:  none
+static int sizeOf(const Node*);
+
+//----------------------------  updateNode  -------------------------------
+// recomputes the height and size of a node from those of its children
+// Preconditions:   the children's heights and sizes are correct
+// Postconditions:  the node's height and size are correct
+static void updateNode(Node*);
+
+//----------------------------  rotateLeft  -------------------------------
+// rotates the subtree left; its right child becomes the subtree's root
+// Preconditions:   the subtree has a right child
+// Postconditions:  in order sequence is unchanged
+static void rotateLeft(Node*&);
+
+//----------------------------  rotateRight  ------------------------------
+// rotates the subtree right; its left child becomes the subtree's root
+// Preconditions:   the subtree has a left child
+// Postconditions:  in order sequence is unchanged
+static void rotateRight(Node*&);
+
+//-------------------------  restoreBalance  ------------------------------
+// fixes the height and size of a subtree and performs the single or
+// double rotation needed to restore the AVL property
+// Preconditions:   both children are AVL trees
+// Postconditions:  subtree is an AVL tree
+static void restoreBalance(Node*&);
+
+//---------------------------  comparisonHelper  --------------------------
+// recursive helper function for the boolean operators (==, !=)
+// Preconditions:   none
+// Postconditions:  returns true if the subtrees match in shape and keys
+bool comparisonHelper(const Node*, const Node*) const;
+
+//-----------------------------  sideways  --------------------------------
+// recursive helper function for display sideways
+// Preconditions:   root is passed, with level 0
+// Postconditions:  none
+static void sideways(const Node*, int);
+
+//------------------------  inorderOstreamHelper  -------------------------
+// recursively puts all keys on an output stream, inorder traversal
+// Preconditions:   the root is passed as a second parameter
+// Postconditions:  none
+static ostream& inorderOstreamHelper(ostream&, const Node*);
+
+};
+
+//---------------------------- NodeDataTree -------------------------------
+// BSTree of NodeData held by value; NodeData's comparisons are not
+// virtual, so less<NodeData> inlines down to the string comparison
+typedef BSTree<NodeData> NodeDataTree;
+
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the comparison and allocator objects to use
+// Preconditions:   none
+// Postconditions:
+//       -- a tree of size 0 is created
+template <class Key, class Compare, class Allocator>
+BSTree<Key, Compare, Allocator>::BSTree(const Compare& compare,
+										const Allocator& alloc)
+	: root(NULL), lessThan(compare), nodeAlloc(alloc) {
+}
+
+//------------------------- Copy Constructor ------------------------------
+// Constructor accepting a BSTree to be deep copied
+// Preconditions:  none
+// Postconditions:
+//       -- a BSTree an exact copy of the parameter is made
+template <class Key, class Compare, class Allocator>
+BSTree<Key, Compare, Allocator>::BSTree(const BSTree& toCopy)
+	: root(NULL), lessThan(toCopy.lessThan),
+	  nodeAlloc(NodeTraits::select_on_container_copy_construction(
+		  toCopy.nodeAlloc)) {
+	root = copyTree(toCopy.root);
+}
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class BSTree
+// Preconditions:   makeEmpty works
+// Postconditions:
+//       -- all nodes are deallocated
+template <class Key, class Compare, class Allocator>
+BSTree<Key, Compare, Allocator>::~BSTree() {
+	makeEmpty();
+}
+
+//----------------------------- isEmpty -----------------------------------
+// Returns true if tree is empty
+// Preconditions:   none
+// Postconditions:  none
+template <class Key, class Compare, class Allocator>
+bool BSTree<Key, Compare, Allocator>::isEmpty() const {
+	return root == NULL;
+}
+
+//---------------------------- makeEmpty ----------------------------------
+// Deallocate all nodes
+// Preconditions:   none
+// Postconditions:
+//       -- no nodes in BSTree, root = NULL
+template <class Key, class Compare, class Allocator>
+void BSTree<Key, Compare, Allocator>::makeEmpty() {
+	makeEmptyHelper(root);
+	root = NULL;
+}
+
+//---------------------------  makeEmptyHelper  ---------------------------
+// recursive helper function for the makeEmpty function
+// Preconditions:   none
+// Postconditions:  every node in the subtree is deallocated
+template <class Key, class Compare, class Allocator>
+void BSTree<Key, Compare, Allocator>::makeEmptyHelper(Node* cur) {
+	if (cur != NULL) {
+		makeEmptyHelper(cur->left);
+		makeEmptyHelper(cur->right);
+		destroyNode(cur);
+	}
+}
+
+//----------------------------  createNode  -------------------------------
+// allocates and constructs a leaf holding a copy of the key
+// Preconditions:   none
+// Postconditions:  returns the new node
+template <class Key, class Compare, class Allocator>
+typename BSTree<Key, Compare, Allocator>::Node*
+BSTree<Key, Compare, Allocator>::createNode(const Key& key) {
+	Node* fresh = NodeTraits::allocate(nodeAlloc, 1);
+	NodeTraits::construct(nodeAlloc, fresh, key);
+	return fresh;
+}
+
+//----------------------------  destroyNode  ------------------------------
+// destroys and deallocates a node
+// Preconditions:   none
+// Postconditions:  none
+template <class Key, class Compare, class Allocator>
+void BSTree<Key, Compare, Allocator>::destroyNode(Node* cur) {
+	NodeTraits::destroy(nodeAlloc, cur);
+	NodeTraits::deallocate(nodeAlloc, cur, 1);
+}
+
+//-----------------------------  copyTree  --------------------------------
+// recursive helper function for copy constructor and assignment operator
+// Preconditions:   none
+// Postconditions:  returns a deep copy of the subtree passed
+template <class Key, class Compare, class Allocator>
+typename BSTree<Key, Compare, Allocator>::Node*
+BSTree<Key, Compare, Allocator>::copyTree(const Node* other) {
+	if (other == NULL)
+		return NULL;
+	Node* cur = createNode(other->key);
+	cur->height = other->height;
+	cur->size = other->size;
+	cur->left = copyTree(other->left);
+	cur->right = copyTree(other->right);
+	return cur;
+}
+
+//------------------------------ insert -----------------------------------
+// Add a copy of a key to the tree, returns true if successful.  No
+// duplicate keys are allowed
+// Preconditions:   insertHelper
+// Postconditions:
+//       -- the key is in a new node placed and balanced in the tree
+template <class Key, class Compare, class Allocator>
+bool BSTree<Key, Compare, Allocator>::insert(const Key& key) {
+	return insertHelper(key, root);
+}
+
+//----------------------------  insertHelper  -----------------------------
+// recursive helper function for the insert function; rebalances every
+// subtree on the way back up
+// Preconditions:   root of this tree is passed as second parameter
+// Postconditions:  returns true if the key was inserted
+template <class Key, class Compare, class Allocator>
+bool BSTree<Key, Compare, Allocator>::insertHelper(const Key& key,
+												   Node*& cur) {
+	if (cur == NULL) {
+		cur = createNode(key);
+		return true;
+	}
+	bool inserted;
+	if (lessThan(key, cur->key))
+		inserted = insertHelper(key, cur->left);
+	else if (lessThan(cur->key, key))
+		inserted = insertHelper(key, cur->right);
+	else //key == cur->key
+		return false; //no duplicates
+	if (inserted)
+		restoreBalance(cur);
+	return inserted;
+}
+
+//---------------------------- retrieve -----------------------------------
+// Retrieve a pointer to the tree's copy of a key, return true if found
+// Preconditions:   none
+// Postconditions:
+//       -- the second parameter points to the found key.  If key is not
+//          found, no reassignment of ptr is made
+template <class Key, class Compare, class Allocator>
+bool BSTree<Key, Compare, Allocator>::retrieve(const Key& toFind,
+											   const Key*& ptr) const {
+	int depth;
+	const Node* found = findNode(toFind, depth);
+	if (found == NULL)
+		return false;
+	ptr = &found->key;
+	return true;
+}
+
+//------------------------------ getDepth ---------------------------------
+// Returns the depth of a key in the tree, the root being 1, or 0 if it is
+// not in the tree
+// Preconditions:   none
+// Postconditions:  none
+template <class Key, class Compare, class Allocator>
+int BSTree<Key, Compare, Allocator>::getDepth(const Key& toFind) const {
+	int depth;
+	return findNode(toFind, depth) == NULL ? 0 : depth;
+}
+
+//-----------------------------  findNode  --------------------------------
+// returns the node holding a key and sets the int to its depth, or
+// returns NULL
+// Preconditions:   none
+// Postconditions:  none
+template <class Key, class Compare, class Allocator>
+const typename BSTree<Key, Compare, Allocator>::Node*
+BSTree<Key, Compare, Allocator>::findNode(const Key& toFind,
+										  int& depth) const {
+	const Node* cur = root;
+	for (depth = 1; cur != NULL; depth++) {
+		if (lessThan(toFind, cur->key))
+			cur = cur->left;
+		else if (lessThan(cur->key, toFind))
+			cur = cur->right;
+		else
+			return cur;
+	}
+	return NULL;
+}
+
+//-------------------------------- size -----------------------------------
+// Returns the number of keys in the tree
+// Preconditions:   none
+// Postconditions:  none
+template <class Key, class Compare, class Allocator>
+int BSTree<Key, Compare, Allocator>::size() const {
+	return sizeOf(root);
+}
+
+//-----------------------------  heightOf  --------------------------------
+// returns the height of the subtree passed, 0 for an empty subtree
+// Preconditions:   none
+// Postconditions:  none
+template <class Key, class Compare, class Allocator>
+int BSTree<Key, Compare, Allocator>::heightOf(const Node* cur) {
+	return cur == NULL ? 0 : cur->height;
+}
+
+//------------------------------  sizeOf  ---------------------------------
+// returns the number of nodes in the subtree passed
+// Preconditions:   none
+// Postconditions:  none
+template <class Key, class Compare, class Allocator>
+int BSTree<Key, Compare, Allocator>::sizeOf(const Node* cur) {
+	return cur == NULL ? 0 : cur->size;
+}
+
+//----------------------------  updateNode  -------------------------------
+// recomputes the height and size of a node from those of its children
+// Preconditions:   the children's heights and sizes are correct
+// Postconditions:  the node's height and size are correct
+template <class Key, class Compare, class Allocator>
+void BSTree<Key, Compare, Allocator>::updateNode(Node* cur) {
+	cur->height = 1 + max(heightOf(cur->left), heightOf(cur->right));
+	cur->size = 1 + sizeOf(cur->left) + sizeOf(cur->right);
+}
+
+//----------------------------  rotateLeft  -------------------------------
+// rotates the subtree left; its right child becomes the subtree's root
+// Preconditions:   the subtree has a right child
+// Postconditions:  in order sequence is unchanged
+template <class Key, class Compare, class Allocator>
+void BSTree<Key, Compare, Allocator>::rotateLeft(Node*& cur) {
+	Node* pivot = cur->right;
+	cur->right = pivot->left;
+	pivot->left = cur;
+	updateNode(cur);
+	updateNode(pivot);
+	cur = pivot;
+}
+
+//----------------------------  rotateRight  ------------------------------
+// rotates the subtree right; its left child becomes the subtree's root
+// Preconditions:   the subtree has a left child
+// Postconditions:  in order sequence is unchanged
+template <class Key, class Compare, class Allocator>
+void BSTree<Key, Compare, Allocator>::rotateRight(Node*& cur) {
+	Node* pivot = cur->left;
+	cur->left = pivot->right;
+	pivot->right = cur;
+	updateNode(cur);
+	updateNode(pivot);
+	cur = pivot;
+}
+
+//-------------------------  restoreBalance  ------------------------------
+// fixes the height and size of a subtree and performs the single or
+// double rotation needed to restore the AVL property
+// Preconditions:   both children are AVL trees
+// Postconditions:  subtree is an AVL tree
+template <class Key, class Compare, class Allocator>
+void BSTree<Key, Compare, Allocator>::restoreBalance(Node*& cur) {
+	updateNode(cur);
+	int skew = heightOf(cur->left) - heightOf(cur->right);
+	if (skew > 1) { //left heavy
+		if (heightOf(cur->left->left) < heightOf(cur->left->right))
+			rotateLeft(cur->left); //left-right case
+		rotateRight(cur);
+	} else if (skew < -1) { //right heavy
+		if (heightOf(cur->right->right) < heightOf(cur->right->left))
+			rotateRight(cur->right); //right-left case
+		rotateLeft(cur);
+	}
+}
+
+//------------------------- displaySideways -------------------------------
+// Displays a binary tree as though you are viewing it from the side;
+// hard coded displaying to standard output.
+// Preconditions:   none
+// Postconditions:  none
+template <class Key, class Compare, class Allocator>
+void BSTree<Key, Compare, Allocator>::displaySideways() const {
+	sideways(root, 0);
+}
+
+//-----------------------------  sideways  --------------------------------
+// recursive helper function for display sideways
+// Preconditions:   root is passed, with level 0
+// Postconditions:  none
+template <class Key, class Compare, class Allocator>
+void BSTree<Key, Compare, Allocator>::sideways(const Node* current,
+											   int level) {
+	if (current != NULL) {
+		level++;
+		sideways(current->right, level);
+
+		// indent for readability, 4 spaces per depth level
+		for (int i = level; i >= 0; i--)
+			cout << "    ";
+
+		cout << current->key << endl;   // display information of object
+		sideways(current->left, level);
+	}
+}
+
+//------------------------------  =  --------------------------------------
+// Overloaded assignment operator; current object = parameter; deep copy
+// Preconditions:   none
+// Postconditions:
+//       -- this tree's nodes are deallocated, and this tree becomes an
+//          exact deep copy of the parameter
+template <class Key, class Compare, class Allocator>
+BSTree<Key, Compare, Allocator>&
+BSTree<Key, Compare, Allocator>::operator=(const BSTree& rhs) {
+	if (this != &rhs) { //if not the same object
+		makeEmpty();
+		lessThan = rhs.lessThan;
+		root = copyTree(rhs.root);
+	}
+	return *this;
+}
+
+//-----------------------------  ==  --------------------------------------
+// Determine if two BSTrees have the same shape and keys; unlike BinTree,
+// equal keys in different shapes compare unequal
+// Preconditions:   none
+// Postconditions:  none
+template <class Key, class Compare, class Allocator>
+bool BSTree<Key, Compare, Allocator>::operator==(const BSTree& rhs) const {
+	return comparisonHelper(root, rhs.root);
+}
+
+//-----------------------------  !=  --------------------------------------
+// Determine if two BSTrees differ in shape or keys
+// Preconditions:   none
+// Postconditions:  none
+template <class Key, class Compare, class Allocator>
+bool BSTree<Key, Compare, Allocator>::operator!=(const BSTree& rhs) const {
+	return !comparisonHelper(root, rhs.root);
+}
+
+//---------------------------  comparisonHelper  --------------------------
+// recursive helper function for the boolean operators (==, !=); stops at
+// the first difference
+// Preconditions:   none
+// Postconditions:  returns true if the subtrees match in shape and keys
+template <class Key, class Compare, class Allocator>
+bool BSTree<Key, Compare, Allocator>::comparisonHelper(const Node* cur,
+		const Node* other) const {
+	if (cur == NULL || other == NULL)
+		return cur == other;
+	if (lessThan(cur->key, other->key) || lessThan(other->key, cur->key))
+		return false;
+	return comparisonHelper(cur->left, other->left) &&
+		   comparisonHelper(cur->right, other->right);
+}
+
+//------------------------  inorderOstreamHelper  -------------------------
+// recursively puts all keys on an output stream, inorder traversal
+// Preconditions:   the root is passed as a second parameter
+// Postconditions:  none
+template <class Key, class Compare, class Allocator>
+ostream& BSTree<Key, Compare, Allocator>::inorderOstreamHelper(ostream& out,
+		const Node* cur) {
+	if (cur != NULL) {
+		inorderOstreamHelper(out, cur->left);
+		out << " " << cur->key;
+		inorderOstreamHelper(out, cur->right);
+	}
+	return out;
+}
+
+#endif
@@ -0,0 +1,409 @@
+//-----------------------------------------------------------------------//
+// BTREE.CPP                                                             //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// BTree is a B-tree holding strings, with the same interface as BinTree //
+//-----------------------------------------------------------------------//
+// B-tree:  every node holds between MINKEYS and MAXKEYS sorted keys     //
+//       (the root may hold fewer) and one more child than keys; every   //
+//       leaf is at the same depth.                                      //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- a Node is 64 byte aligned and starts with its prefixes, MAXKEYS  //
+//      of them rounded up to whole cache lines: with MAXKEYS 15, the    //
+//      prefixes fill exactly two lines, one slot spare, and the counts, //
+//      key and child pointers four more                                 //
+//-----------------------------------------------------------------------//
+
+#include "btree.h"
+
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class BTree
+// Preconditions:   none
+// Postconditions:
+//       -- a tree of size 0 is created
+BTree::BTree() {
+	root = NULL;
+	keyCount = 0;
+}
+
+//------------------------- Copy Constructor ------------------------------
+// Constructor accepting a BTree to be deep copied
+// Preconditions:  none
+// Postconditions:
+//       -- a BTree an exact copy of the parameter is made
+BTree::BTree(const BTree& toCopy) {
+	root = copyTree(toCopy.root);
+	keyCount = toCopy.keyCount;
+}
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class BTree
+// Preconditions:   makeEmpty works
+// Postconditions:
+//       -- all nodes and NodeDatas in BTree are deallocated
+BTree::~BTree() {
+	makeEmpty();
+}
+
+//----------------------------- isEmpty -----------------------------------
+// Returns true if tree is empty
+// Preconditions:   none
+// Postconditions:  none
+bool BTree::isEmpty() const {
+	return root == NULL;
+}
+
+//---------------------------- makeEmpty ----------------------------------
+// Deallocate all nodes and NodeDatas in BTree
+// Preconditions:   none
+// Postconditions:
+//       -- no nodes in BTree, root = NULL
+void BTree::makeEmpty() {
+	makeEmptyHelper(root);
+	root = NULL;
+	keyCount = 0;
+}
+
+//---------------------------  makeEmptyHelper  ---------------------------
+// recursive helper function for the makeEmpty function
+// Preconditions:   none
+// Postconditions:  every node and NodeData in the subtree is deallocated
+void BTree::makeEmptyHelper(Node* cur) {
+	if (cur != NULL) {
+		for (int i = 0; i < cur->count; i++)
+			delete cur->keys[i];
+		if (!cur->leaf) {
+			for (int i = 0; i <= cur->count; i++)
+				makeEmptyHelper(cur->children[i]);
+		}
+		delete cur;
+	}
+}
+
+//----------------------------  createNode  -------------------------------
+// allocates an empty node
+// Preconditions:   none
+// Postconditions:  returns the node, with no keys or children
+BTree::Node* BTree::createNode(bool leaf) {
+	Node* fresh = new Node;
+	fresh->count = 0;
+	fresh->leaf = leaf;
+	for (int i = 0; i <= MAXKEYS; i++)
+		fresh->children[i] = NULL;
+	return fresh;
+}
+
+//------------------------------ insert -----------------------------------
+// Add a NodeData to BTree, returns true if successful
+// Preconditions:   none
+// Postconditions:
+//       -- the NodeData is owned by the tree if true is returned; false
+//          means an equal NodeData is already in the tree
+bool BTree::insert(NodeData* newNodeData) {
+	NodeData* found;
+	if (retrieve(*newNodeData, found))
+		return false; //no duplicates
+	if (root == NULL)
+		root = createNode(true);
+	if (root->count == MAXKEYS) { //tree grows in height at the root only
+		Node* newRoot = createNode(false);
+		newRoot->children[0] = root;
+		root = newRoot;
+		splitChild(root, 0);
+	}
+	insertNonFull(root, newNodeData);
+	keyCount++;
+	return true;
+}
+
+//----------------------------  splitChild  -------------------------------
+// splits the full child at an index of a node, moving its middle key up
+// Preconditions:   the node is not full; the child is full
+// Postconditions:  both halves hold MINKEYS keys
+void BTree::splitChild(Node* parent, int index) {
+	Node* full = parent->children[index];
+	Node* right = createNode(full->leaf);
+	right->count = MINKEYS;
+	for (int i = 0; i < MINKEYS; i++) { //upper half moves right
+		right->prefixes[i] = full->prefixes[MINKEYS + 1 + i];
+		right->keys[i] = full->keys[MINKEYS + 1 + i];
+	}
+	if (!full->leaf) {
+		for (int i = 0; i <= MINKEYS; i++) {
+			right->children[i] = full->children[MINKEYS + 1 + i];
+			full->children[MINKEYS + 1 + i] = NULL;
+		}
+	}
+	full->count = MINKEYS;
+	for (int i = parent->count; i > index; i--) { //open a gap in parent
+		parent->prefixes[i] = parent->prefixes[i-1];
+		parent->keys[i] = parent->keys[i-1];
+		parent->children[i+1] = parent->children[i];
+	}
+	parent->prefixes[index] = full->prefixes[MINKEYS]; //middle key moves up
+	parent->keys[index] = full->keys[MINKEYS];
+	parent->children[index+1] = right;
+	parent->count++;
+}
+
+//---------------------------  insertNonFull  -----------------------------
+// inserts into the subtree of a node that is not full, splitting full
+// children on the way down
+// Preconditions:   the NodeData is not in the tree; the node is not full
+// Postconditions:  the NodeData is in a leaf of the subtree
+void BTree::insertNonFull(Node* cur, NodeData* newNodeData) {
+	unsigned long long prefix = newNodeData->keyPrefix();
+	for (;;) {
+		int index = lowerBound(cur, *newNodeData, prefix);
+		if (cur->leaf) {
+			for (int i = cur->count; i > index; i--) {
+				cur->prefixes[i] = cur->prefixes[i-1];
+				cur->keys[i] = cur->keys[i-1];
+			}
+			cur->prefixes[index] = prefix;
+			cur->keys[index] = newNodeData;
+			cur->count++;
+			return;
+		}
+		if (cur->children[index]->count == MAXKEYS) {
+			splitChild(cur, index);
+			if (*cur->keys[index] < *newNodeData) //goes in the right half
+				index++;
+		}
+		cur = cur->children[index];
+	}
+}
+
+//----------------------------  lowerBound  -------------------------------
+// returns the index of the first key in a node not less than the object;
+// the prefixes decide unless they tie
+// Preconditions:   the prefix passed is the object's keyPrefix
+// Postconditions:  none
+int BTree::lowerBound(const Node* cur, const NodeData& toFind,
+					  unsigned long long prefix) {
+	int index = 0;
+	while (index < cur->count && cur->prefixes[index] < prefix)
+		index++;
+	while (index < cur->count && cur->prefixes[index] == prefix &&
+		   *cur->keys[index] < toFind)
+		index++;
+	return index;
+}
+
+//---------------------------  isKeyAt  -----------------------------------
+// returns true if the key at an index of a node equals the object
+// Preconditions:   the prefix passed is the object's keyPrefix
+// Postconditions:  none
+bool BTree::isKeyAt(const Node* cur, int index, const NodeData& toFind,
+					unsigned long long prefix) {
+	return index < cur->count && cur->prefixes[index] == prefix &&
+		   *cur->keys[index] == toFind;
+}
+
+//---------------------------- retrieve -----------------------------------
+// Retrieve a NodeData* of a given object in the tree, return true if found
+// Preconditions:   none
+// Postconditions:
+//       -- the second parameter points to the found object.  If object
+//          is not found, no reassignment of ptr is made
+bool BTree::retrieve(const NodeData& toFind, NodeData*& ptr) const {
+	unsigned long long prefix = toFind.keyPrefix();
+	const Node* cur = root;
+	while (cur != NULL) {
+		int index = lowerBound(cur, toFind, prefix);
+		if (isKeyAt(cur, index, toFind, prefix)) {
+			ptr = cur->keys[index];
+			return true;
+		}
+		cur = cur->leaf ? NULL : cur->children[index];
+	}
+	return false;
+}
+
+//------------------------------ getDepth ---------------------------------
+// Returns the depth of the node holding a given value, the root being 1,
+// or 0 if it is not in the tree
+// Preconditions:   none
+// Postconditions:  none
+int BTree::getDepth(const NodeData& toFind) const {
+	unsigned long long prefix = toFind.keyPrefix();
+	const Node* cur = root;
+	for (int depth = 1; cur != NULL; depth++) {
+		int index = lowerBound(cur, toFind, prefix);
+		if (isKeyAt(cur, index, toFind, prefix))
+			return depth;
+		cur = cur->leaf ? NULL : cur->children[index];
+	}
+	return 0;
+}
+
+//-------------------------------- size -----------------------------------
+// Returns the number of NodeDatas in the tree
+// Preconditions:   none
+// Postconditions:  none
+int BTree::size() const {
+	return keyCount;
+}
+
+//-----------------------------  copyTree  --------------------------------
+// recursive helper function for copy constructor and assignment operator
+// Preconditions:   none
+// Postconditions:  returns a deep copy of the subtree passed
+BTree::Node* BTree::copyTree(const Node* other) {
+	if (other == NULL)
+		return NULL;
+	Node* cur = createNode(other->leaf);
+	cur->count = other->count;
+	for (int i = 0; i < other->count; i++) {
+		cur->prefixes[i] = other->prefixes[i];
+		cur->keys[i] = new NodeData(*other->keys[i]);
+	}
+	if (!other->leaf) {
+		for (int i = 0; i <= other->count; i++)
+			cur->children[i] = copyTree(other->children[i]);
+	}
+	return cur;
+}
+
+//------------------------------  =  --------------------------------------
+// Overloaded assignment operator; current object = parameter; deep copy
+// Preconditions:   none
+// Postconditions:
+//       -- this tree's nodes are deallocated, and this tree becomes an
+//          exact deep copy of the parameter
+BTree& BTree::operator=(const BTree& rhs) {
+	if (this != &rhs) {
+		makeEmpty();
+		root = copyTree(rhs.root);
+		keyCount = rhs.keyCount;
+	}
+	return *this;
+}
+
+//-----------------------------  ==  --------------------------------------
+// Determine if two BTrees hold the same NodeDatas
+// Preconditions:   none
+// Postconditions:  none
+bool BTree::operator==(const BTree& rhs) const {
+	if (keyCount != rhs.keyCount)
+		return false;
+	vector<const NodeData*> mine, theirs;
+	mine.reserve(keyCount);
+	theirs.reserve(keyCount);
+	collectHelper(root, mine);
+	collectHelper(rhs.root, theirs);
+	for (size_t i = 0; i < mine.size(); i++) {
+		if (*mine[i] != *theirs[i])
+			return false;
+	}
+	return true;
+}
+
+//-----------------------------  !=  --------------------------------------
+// Determine if two BTrees do not hold the same NodeDatas
+// Preconditions:   none
+// Postconditions:  none
+bool BTree::operator!=(const BTree& rhs) const {
+	return !(*this == rhs);
+}
+
+//--------------------------  collectHelper  ------------------------------
+// recursive helper for operator==; appends the NodeDatas in order
+// Preconditions:   none
+// Postconditions:  none
+void BTree::collectHelper(const Node* cur, vector<const NodeData*>& out) {
+	if (cur != NULL) {
+		for (int i = 0; i < cur->count; i++) {
+			if (!cur->leaf)
+				collectHelper(cur->children[i], out);
+			out.push_back(cur->keys[i]);
+		}
+		if (!cur->leaf)
+			collectHelper(cur->children[cur->count], out);
+	}
+}
+
+//------------------------- displaySideways -------------------------------
+// Displays the tree as though you are viewing it from the side, one key
+// per line, indented 4 spaces per node level; hard coded displaying to
+// standard output.
+// Preconditions:   none
+// Postconditions:  none
+void BTree::displaySideways() const {
+	sideways(root, 0);
+}
+
+//-----------------------------  sideways  --------------------------------
+// recursive helper function for display sideways
+// Preconditions:   root is passed, with level 0
+// Postconditions:  none
+void BTree::sideways(const Node* current, int level) {
+	if (current != NULL) {
+		level++;
+		for (int i = current->count; i >= 0; i--) {
+			if (!current->leaf)
+				sideways(current->children[i], level);
+			if (i > 0) {
+				// indent for readability, 4 spaces per depth level
+				for (int j = level; j >= 0; j--)
+					cout << "    ";
+				cout << *current->keys[i-1] << endl;
+			}
+		}
+	}
+}
+
+//-----------------------------  <<  --------------------------------------
+// Overloaded output operator for class BTree
+// Preconditions:   NodeData has a working output operator overload
+// Postconditions:  prints an in order traversal of the tree to the consol
+ostream& operator<<(ostream& out, const BTree& toPrint) {
+	if (toPrint.root == NULL) { //if tree is empty
+		out << "Empty" << endl;
+		return out;
+	} else {
+		BTree::inorderOstreamHelper(out, toPrint.root);
+		out << endl;
+		return out;
+	}
+}
+
+//------------------------  inorderOstreamHelper  -------------------------
+// recursively puts all node data on an output stream, inorder traversal
+// Preconditions:   the root is passed as a second parameter
+// Postconditions:  none
+ostream& BTree::inorderOstreamHelper(ostream& out, const Node* cur) {
+	if (cur != NULL) {
+		for (int i = 0; i < cur->count; i++) {
+			if (!cur->leaf)
+				inorderOstreamHelper(out, cur->children[i]);
+			out << " " << *cur->keys[i];
+		}
+		if (!cur->leaf)
+			inorderOstreamHelper(out, cur->children[cur->count]);
+	}
+	return out;
+}
+
+//-----------------------------  >>  --------------------------------------
+// Overloaded input operator for class BTree; adds new keys to BTree
+// 		-- each separate string inputted (separated by whitespace) is added
+//         as a new key in BTree
+// 		-- input "$$" to end the input stream
+// Preconditions:   insert(NodeData*) is working
+// Postconditions:  All the tokens are a part of the tree
+istream& operator>>(istream& in, BTree& rhs) {
+	string newData = "$$";
+	for (;;) {
+		in >> newData;
+		if (newData == "$$" || !in)
+			break;
+		NodeData* newNodeData = new NodeData(newData);
+		if (!rhs.insert(newNodeData))
+			delete newNodeData; //duplicate, not inserted
+	}
+	return in;
+}
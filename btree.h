@@ -0,0 +1,225 @@
+//-----------------------------------------------------------------------//
+// BTREE.H                                                               //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// BTree is a B-tree holding strings, with the same interface as BinTree //
+//-----------------------------------------------------------------------//
+// B-tree:  every node holds between MINKEYS and MAXKEYS sorted keys     //
+//       (the root may hold fewer) and one more child than keys; every   //
+//       leaf is at the same depth.                                      //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- a node keeps the keyPrefix of each of its keys in one array, so  //
+//      the search within a node is a scan over a few cache lines of     //
+//      integers; the strings are only read to break a prefix tie        //
+//   -- full nodes are split on the way down an insert (CLRS), so an     //
+//      insert never has to walk back up                                 //
+//   -- getDepth returns the depth of the node holding the key, so it is //
+//      not comparable with BinTree::getDepth                            //
+//   -- operator== compares contents, since the shape of a B-tree says   //
+//      little about what it holds                                       //
+//-----------------------------------------------------------------------//
+
+#ifndef BTREE_H
+#define BTREE_H
+#include <iostream>
+#include <vector>
+#include "nodedata.h"
+using namespace std;
+
+
+class BTree {
+//-----------------------------  <<  --------------------------------------
+// Overloaded output operator for class BTree
+// Preconditions:   NodeData has a working output operator overload
+// Postconditions:  prints an in order traversal of the tree
+friend ostream& operator<<(ostream&, const BTree&);
+
+//-----------------------------  >>  --------------------------------------
+// Overloaded input operator for class BTree; adds new keys to BTree
+// 		-- each separate string inputted (separated by whitespace) is added
+//         as a new key in BTree
+// 		-- input "$$" to end the input stream
+// Preconditions:   insert(NodeData*) is working
+// Postconditions:  All the tokens are a part of the tree
+friend istream& operator>>(istream&, BTree&);
+
+public:
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class BTree
+// Preconditions:   none
+// Postconditions:
+//       -- a tree of size 0 is created
+BTree();
+
+//------------------------- Copy Constructor ------------------------------
+// Constructor accepting a BTree to be deep copied
+// Preconditions:  none
+// Postconditions:
+//       -- a BTree an exact copy of the parameter is made
+BTree(const BTree&);
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class BTree
+// Preconditions:   none
+// Postconditions:
+//       -- all nodes and NodeDatas in BTree are deallocated
+~BTree();
+
+//----------------------------- isEmpty -----------------------------------
+// Returns true if tree is empty
+// Preconditions:   none
+// Postconditions:  none
+bool isEmpty() const;
+
+//---------------------------- makeEmpty ----------------------------------
+// Deallocate all nodes and NodeDatas in BTree
+// Preconditions:   none
+// Postconditions:
+//       -- no nodes in BTree, root = NULL
+void makeEmpty();
+
+//------------------------------ insert -----------------------------------
+// Add a NodeData to BTree, returns true if successful
+// Preconditions:   none
+// Postconditions:
+//       -- the NodeData is owned by the tree if true is returned; false
+//          means an equal NodeData is already in the tree
+bool insert(NodeData*);
+
+//---------------------------- retrieve -----------------------------------
+// Retrieve a NodeData* of a given object in the tree, return true if found
+// Preconditions:   none
+// Postconditions:
+//       -- the second parameter points to the found object.  If object
+//          is not found, no reassignment of ptr is made
+bool retrieve(const NodeData&, NodeData*&) const;
+
+//------------------------------ getDepth ---------------------------------
+// Returns the depth of the node holding a given value, the root being 1,
+// or 0 if it is not in the tree
+// Preconditions:   none
+// Postconditions:  none
+int getDepth(const NodeData&) const;
+
+//-------------------------------- size -----------------------------------
+// Returns the number of NodeDatas in the tree
+// Preconditions:   none
+// Postconditions:  none
+int size() const;
+
+//------------------------- displaySideways -------------------------------
+// Displays the tree as though you are viewing it from the side, one key
+// per line, indented 4 spaces per node level; hard coded displaying to
+// standard output.
+// Preconditions:   none
+// Postconditions:  none
+void displaySideways() const;
+
+//------------------------------  =  --------------------------------------
+// Overloaded assignment operator; current object = parameter; deep copy
+// Preconditions:   none
+// Postconditions:
+//       -- this tree's nodes are deallocated, and this tree becomes an
+//          exact deep copy of the parameter
+BTree& operator=(const BTree&);
+
+//-----------------------------  ==  --------------------------------------
+// Determine if two BTrees hold the same NodeDatas
+// Preconditions:   none
+// Postconditions:  none
+bool operator==(const BTree&) const;
+
+//-----------------------------  !=  --------------------------------------
+// Determine if two BTrees do not hold the same NodeDatas
+// Preconditions:   none
+// Postconditions:  none
+bool operator!=(const BTree&) const;
+
+private:
+static const int MINKEYS = 7;               //fewest keys in a non-root node
+static const int MAXKEYS = 2 * MINKEYS + 1; //most keys in any node
+static const int LINEPREFIXES = 8;          //keyPrefixes in a cache line
+static const int PREFIXSLOTS = (MAXKEYS + LINEPREFIXES - 1) /
+							   LINEPREFIXES * LINEPREFIXES;
+											//MAXKEYS, in whole lines
+
+struct alignas(64) Node {                   //starts on a cache line
+	unsigned long long prefixes[PREFIXSLOTS]; //keyPrefix of each key
+	int count;                              //keys in use
+	bool leaf;                              //no children
+	NodeData* keys[MAXKEYS];                //sorted keys
+	Node* children[MAXKEYS + 1];            //children[i] holds keys < keys[i]
+};
+
+Node* root;         //root of the tree
+int keyCount;       //number of NodeDatas in the tree
+
+//utility functions
+
+//----------------------------  createNode  -------------------------------
+// allocates an empty node
+// Preconditions:   none
+// Postconditions:  returns the node, with no keys or children
+static Node* createNode(bool);
+
+//----------------------------  lowerBound  -------------------------------
+// returns the index of the first key in a node not less than the object
+// Preconditions:   the prefix passed is the object's keyPrefix
+// Postconditions:  none
+static int lowerBound(const Node*, const NodeData&, unsigned long long);
+
+//---------------------------  isKeyAt  -----------------------------------
+// returns true if the key at an index of a node equals the object
+// Preconditions:   the prefix passed is the object's keyPrefix
+// Postconditions:  none
+static bool isKeyAt(const Node*, int, const NodeData&, unsigned long long);
+
+//----------------------------  splitChild  -------------------------------
+// splits the full child at an index of a node, moving its middle key up
+// Preconditions:   the node is not full; the child is full
+// Postconditions:  both halves hold MINKEYS keys
+static void splitChild(Node*, int);
+
+//---------------------------  insertNonFull  -----------------------------
+// inserts into the subtree of a node that is not full, splitting full
+// children on the way down
+// Preconditions:   the NodeData is not in the tree; the node is not full
+// Postconditions:  the NodeData is in a leaf of the subtree
+static void insertNonFull(Node*, NodeData*);
+
+//-----------------------------  copyTree  --------------------------------
+// recursive helper function for copy constructor and assignment operator
+// Preconditions:   none
+// Postconditions:  returns a deep copy of the subtree passed
+static Node* copyTree(const Node*);
+
+//---------------------------  makeEmptyHelper  ---------------------------
+// recursive helper function for the makeEmpty function
+// Preconditions:   none
+// Postconditions:  every node and NodeData in the subtree is deallocated
+static void makeEmptyHelper(Node*);
+
+//--------------------------  collectHelper  ------------------------------
+// recursive helper for operator==; appends the NodeDatas in order
+// Preconditions:   none
+// Postconditions:  none
+static void collectHelper(const Node*, vector<const NodeData*>&);
+
+//-----------------------------  sideways  --------------------------------
+// recursive helper function for display sideways
+// Preconditions:   root is passed, with level 0
+// Postconditions:  none
+static void sideways(const Node*, int);
+
+//------------------------  inorderOstreamHelper  -------------------------
+// recursively puts all node data on an output stream, inorder traversal
+// Preconditions:   the root is passed as a second parameter
+// Postconditions:  none
+static ostream& inorderOstreamHelper(ostream&, const Node*);
+
+};
+
+#endif
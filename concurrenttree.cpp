@@ -0,0 +1,408 @@
+//-----------------------------------------------------------------------//
+// CONCURRENTTREE.CPP                                                    //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// ConcurrentTree is an AVL tree of strings that many threads can read   //
+// without locks while other threads insert                              //
+//-----------------------------------------------------------------------//
+// Snapshot publishing:  a published Node is never changed.  An insert   //
+//       copies the Nodes on its search path and publishes the new root  //
+//       with one atomic store.                                          //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- writers on different shards share only the epoch counter and the //
+//      reader slots, both of which they only read except to advance     //
+//   -- every atomic operation is sequentially consistent; a reader's    //
+//      pin must be visible before it loads the root, and a writer's     //
+//      root store before it reads the reader slots                      //
+//-----------------------------------------------------------------------//
+
+#include "concurrenttree.h"
+#include <algorithm>
+#include <thread>
+#include <queue>
+#include <utility>
+
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class ConcurrentTree
+// Preconditions:   none
+// Postconditions:
+//       -- a tree of size 0 is created
+ConcurrentTree::ConcurrentTree() : epoch(1) {
+	shardCount = 1;
+	shards = new Shard[shardCount];
+	shards[0].root.store(NULL);
+	for (int i = 0; i < READERSLOTS; i++)
+		slots[i].epoch.store(0);
+}
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the number of shards; more shards let more
+// writers insert at once
+// Preconditions:   the int is at least 1
+// Postconditions:
+//       -- a tree of size 0 is created
+ConcurrentTree::ConcurrentTree(int count) : epoch(1) {
+	shardCount = max(count, 1);
+	shards = new Shard[shardCount];
+	for (int i = 0; i < shardCount; i++)
+		shards[i].root.store(NULL);
+	for (int i = 0; i < READERSLOTS; i++)
+		slots[i].epoch.store(0);
+}
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class ConcurrentTree
+// Preconditions:   no thread is using the tree
+// Postconditions:
+//       -- all Nodes, retired Nodes and NodeDatas are deallocated
+ConcurrentTree::~ConcurrentTree() {
+	for (int s = 0; s < shardCount; s++) {
+		deleteSubtree(shards[s].root.load());
+		vector<Retired>& retired = shards[s].retired;
+		for (size_t i = 0; i < retired.size(); i++)
+			delete retired[i].node; //its NodeData lives on in a newer Node
+	}
+	delete[] shards;
+}
+
+//---------------------------  deleteSubtree  -----------------------------
+// recursive helper for the destructor; deletes the Nodes and NodeDatas
+// Preconditions:   no reader is walking the subtree
+// Postconditions:  none
+void ConcurrentTree::deleteSubtree(Node* cur) {
+	if (cur != NULL) {
+		deleteSubtree(cur->left);
+		deleteSubtree(cur->right);
+		delete cur->data;
+		delete cur;
+	}
+}
+
+//----------------------------  ReadGuard  --------------------------------
+// pins the current epoch in a free reader slot for as long as it lives;
+// the thread's last slot is tried first, so a reader usually pins with
+// one uncontended compare and swap
+ConcurrentTree::ReadGuard::ReadGuard(const ConcurrentTree& tree) {
+	static atomic<unsigned> nextHome(0);
+	thread_local unsigned home = nextHome++;
+	for (unsigned tries = 0;; tries++) {
+		ReaderSlot* candidate = &tree.slots[(home + tries) % READERSLOTS];
+		unsigned long unused = 0;
+		if (candidate->epoch.compare_exchange_strong(unused,
+													 tree.epoch.load())) {
+			slot = candidate;
+			home = (home + tries) % READERSLOTS;
+			return;
+		}
+		if (tries % READERSLOTS == READERSLOTS - 1) //every slot is taken
+			this_thread::yield();
+	}
+}
+
+//----------------------------  ~ReadGuard  -------------------------------
+// clears the reader slot, letting the epoch move on
+ConcurrentTree::ReadGuard::~ReadGuard() {
+	slot->epoch.store(0);
+}
+
+//------------------------------ insert -----------------------------------
+// Add a NodeData to the tree and publish the new version, returns true if
+// successful.  No duplicate NodeDatas are allowed
+// Preconditions:   none; safe to call from any thread, locks the shard
+//       the NodeData hashes to
+// Postconditions:
+//       -- the NodeData is owned by the tree if true is returned; readers
+//          that start after insert returns will find it
+bool ConcurrentTree::insert(NodeData* newNodeData) {
+	Shard& shard = shardFor(*newNodeData); //equal keys share a shard
+	lock_guard<mutex> lock(shard.writeLock);
+	bool inserted = false;
+	vector<Node*> replaced;
+	Node* newRoot = insertHelper(shard.root.load(), newNodeData, inserted,
+								 replaced);
+	if (!inserted)
+		return false; //no duplicates, and nothing was copied
+	shard.root.store(newRoot);
+	unsigned long now = epoch.load();
+	for (size_t i = 0; i < replaced.size(); i++) {
+		Retired entry = { replaced[i], now };
+		shard.retired.push_back(entry);
+	}
+	reclaim(shard);
+	return true;
+}
+
+//----------------------------  shardFor  ---------------------------------
+// returns the shard a NodeData hashes to
+// Preconditions:   none
+// Postconditions:  none
+ConcurrentTree::Shard& ConcurrentTree::shardFor(const NodeData& key) const {
+	return shards[key.hash() % (size_t)shardCount];
+}
+
+//---------------------------  insertHelper  ------------------------------
+// recursive helper for insert; returns the root of a new version of the
+// subtree holding the NodeData, sharing every subtree off the path with
+// the old version
+// Preconditions:   the shard's writer lock is held
+// Postconditions:  the replaced Nodes are appended to the vector; returns
+//			the old subtree unchanged if the NodeData is a duplicate
+ConcurrentTree::Node* ConcurrentTree::insertHelper(Node* cur,
+		NodeData* newNodeData, bool& inserted, vector<Node*>& replaced) {
+	if (cur == NULL) {
+		inserted = true;
+		return createNode(newNodeData, NULL, NULL);
+	}
+	int order = newNodeData->compare(*cur->data);
+	if (order < 0) {
+		Node* left = insertHelper(cur->left, newNodeData, inserted, replaced);
+		if (!inserted)
+			return cur;
+		replaced.push_back(cur);
+		return balanced(cur->data, left, cur->right);
+	} else if (order > 0) {
+		Node* right = insertHelper(cur->right, newNodeData, inserted,
+								   replaced);
+		if (!inserted)
+			return cur;
+		replaced.push_back(cur);
+		return balanced(cur->data, cur->left, right);
+	} else //newNodeData == cur->data
+		return cur;
+}
+
+//-----------------------------  reclaim  ---------------------------------
+// advances the epoch if every pinned reader is in the current one, then
+// deletes the shard's retired Nodes no reader can reach any more
+// Preconditions:   the shard's writer lock is held
+// Postconditions:  none
+void ConcurrentTree::reclaim(Shard& shard) {
+	unsigned long now = epoch.load();
+	bool allCurrent = true;
+	for (int i = 0; i < READERSLOTS && allCurrent; i++) {
+		unsigned long pinned = slots[i].epoch.load();
+		if (pinned != 0 && pinned != now)
+			allCurrent = false;
+	}
+	if (allCurrent) //another shard's writer may have advanced it already
+		epoch.compare_exchange_strong(now, now + 1);
+	now = epoch.load();
+	vector<Retired>& retired = shard.retired;
+	size_t kept = 0;
+	for (size_t i = 0; i < retired.size(); i++) {
+		if (retired[i].epoch + 2 <= now)
+			delete retired[i].node;
+		else
+			retired[kept++] = retired[i];
+	}
+	retired.resize(kept);
+}
+
+//---------------------------- retrieve -----------------------------------
+// Retrieve a NodeData* of a given object in the tree, return true if found
+// Preconditions:   none; safe to call from any thread, takes no lock
+// Postconditions:
+//       -- the second parameter points to the found object.  If object
+//          is not found, no reassignment of ptr is made
+bool ConcurrentTree::retrieve(const NodeData& toFind, NodeData*& ptr) const {
+	ReadGuard guard(*this);
+	const Node* cur = shardFor(toFind).root.load();
+	while (cur != NULL) {
+		int order = toFind.compare(*cur->data);
+		if (order == 0) {
+			ptr = cur->data;
+			return true;
+		}
+		cur = order < 0 ? cur->left : cur->right;
+	}
+	return false;
+}
+
+//------------------------------ getDepth ---------------------------------
+// Returns the depth of a given value in the published tree, the root
+// being 1, or 0 if it is not in the tree
+// Preconditions:   none; safe to call from any thread, takes no lock
+// Postconditions:  none
+int ConcurrentTree::getDepth(const NodeData& toFind) const {
+	ReadGuard guard(*this);
+	const Node* cur = shardFor(toFind).root.load();
+	for (int depth = 1; cur != NULL; depth++) {
+		int order = toFind.compare(*cur->data);
+		if (order == 0)
+			return depth;
+		cur = order < 0 ? cur->left : cur->right;
+	}
+	return 0;
+}
+
+//-------------------------------- size -----------------------------------
+// Returns the number of NodeDatas in the published tree, summed over the
+// shards
+// Preconditions:   none; safe to call from any thread, takes no lock
+// Postconditions:  none
+int ConcurrentTree::size() const {
+	ReadGuard guard(*this);
+	int total = 0;
+	for (int s = 0; s < shardCount; s++)
+		total += sizeOf(shards[s].root.load());
+	return total;
+}
+
+//----------------------------- isEmpty -----------------------------------
+// Returns true if the published tree has no Nodes
+// Preconditions:   none; safe to call from any thread, takes no lock
+// Postconditions:  none
+bool ConcurrentTree::isEmpty() const {
+	for (int s = 0; s < shardCount; s++) {
+		if (shards[s].root.load() != NULL) //no Node is touched, no pin
+			return false;
+	}
+	return true;
+}
+
+//----------------------------  createNode  -------------------------------
+// allocates a Node with the children passed and computes its height and
+// size from them
+// Preconditions:   none
+// Postconditions:  returns the new, not yet published Node
+ConcurrentTree::Node* ConcurrentTree::createNode(NodeData* nodeData,
+												 Node* left, Node* right) {
+	Node* fresh = new Node;
+	fresh->data = nodeData;
+	fresh->left = left;
+	fresh->right = right;
+	updateNode(fresh);
+	return fresh;
+}
+
+//-----------------------------  heightOf  --------------------------------
+// returns the height of the subtree passed, 0 for an empty subtree
+// Preconditions:   none
+// Postconditions:  none
+int ConcurrentTree::heightOf(const Node* cur) {
+	return cur == NULL ? 0 : cur->height;
+}
+
+//------------------------------  sizeOf  ---------------------------------
+// returns the number of Nodes in the subtree passed
+// Preconditions:   none
+// Postconditions:  none
+int ConcurrentTree::sizeOf(const Node* cur) {
+	return cur == NULL ? 0 : cur->size;
+}
+
+//----------------------------  updateNode  -------------------------------
+// recomputes the height and size of a Node from those of its children
+// Preconditions:   the Node is not yet published
+// Postconditions:  the Node's height and size are correct
+void ConcurrentTree::updateNode(Node* cur) {
+	cur->height = 1 + max(heightOf(cur->left), heightOf(cur->right));
+	cur->size = 1 + sizeOf(cur->left) + sizeOf(cur->right);
+}
+
+//----------------------------  rotateLeft  -------------------------------
+// rotates a subtree left and returns its new root
+// Preconditions:   the subtree root and its right child are unpublished
+// Postconditions:  in order sequence is unchanged, heights and sizes
+//			are correct
+ConcurrentTree::Node* ConcurrentTree::rotateLeft(Node* cur) {
+	Node* pivot = cur->right;
+	cur->right = pivot->left;
+	pivot->left = cur;
+	updateNode(cur);
+	updateNode(pivot);
+	return pivot;
+}
+
+//----------------------------  rotateRight  ------------------------------
+// rotates a subtree right and returns its new root
+// Preconditions:   the subtree root and its left child are unpublished
+// Postconditions:  in order sequence is unchanged, heights and sizes
+//			are correct
+ConcurrentTree::Node* ConcurrentTree::rotateRight(Node* cur) {
+	Node* pivot = cur->left;
+	cur->left = pivot->right;
+	pivot->right = cur;
+	updateNode(cur);
+	updateNode(pivot);
+	return pivot;
+}
+
+//----------------------------  balanced  ---------------------------------
+// builds the Node for a key over two subtrees, rotating so that the AVL
+// property holds.  Only Nodes this insert created are rotated, since the
+// heavy side of an AVL insert is always the side it went down
+// Preconditions:   the subtree heights differ by at most 2
+// Postconditions:  returns the root of the balanced subtree
+ConcurrentTree::Node* ConcurrentTree::balanced(NodeData* nodeData,
+											   Node* left, Node* right) {
+	Node* cur = createNode(nodeData, left, right);
+	int skew = heightOf(left) - heightOf(right);
+	if (skew > 1) { //left heavy
+		if (heightOf(left->left) < heightOf(left->right))
+			cur->left = rotateLeft(left); //left-right case
+		cur = rotateRight(cur);
+	} else if (skew < -1) { //right heavy
+		if (heightOf(right->right) < heightOf(right->left))
+			cur->right = rotateRight(right); //right-left case
+		cur = rotateLeft(cur);
+	}
+	return cur;
+}
+
+//-----------------------------  <<  --------------------------------------
+// Overloaded output operator for class ConcurrentTree
+// Preconditions:   NodeData has a working output operator overload
+// Postconditions:  prints an in order traversal of the published
+//       versions of the shards, merged
+ostream& operator<<(ostream& out, const ConcurrentTree& toPrint) {
+	typedef pair<const NodeData*, int> Head; //next NodeData of a shard
+	struct LaterFirst {
+		bool operator()(const Head& a, const Head& b) const {
+			return *b.first < *a.first;
+		}
+	};
+	vector<vector<const NodeData*> > sorted(toPrint.shardCount);
+	{
+		ConcurrentTree::ReadGuard guard(toPrint);
+		for (int s = 0; s < toPrint.shardCount; s++)
+			ConcurrentTree::collectHelper(toPrint.shards[s].root.load(),
+										  sorted[s]);
+	}
+	priority_queue<Head, vector<Head>, LaterFirst> heads;
+	vector<size_t> next(toPrint.shardCount, 0);
+	for (int s = 0; s < toPrint.shardCount; s++) {
+		if (!sorted[s].empty())
+			heads.push(Head(sorted[s][next[s]++], s));
+	}
+	if (heads.empty()) { //if tree is empty
+		out << "Empty" << endl;
+		return out;
+	}
+	while (!heads.empty()) { //k-way merge of the shards
+		Head smallest = heads.top();
+		heads.pop();
+		out << " " << *smallest.first;
+		int s = smallest.second;
+		if (next[s] < sorted[s].size())
+			heads.push(Head(sorted[s][next[s]++], s));
+	}
+	out << endl;
+	return out;
+}
+
+//----------------------------  collectHelper  ----------------------------
+// recursive helper for operator<<; appends a shard's NodeDatas in order
+// Preconditions:   the caller holds a ReadGuard
+// Postconditions:  none
+void ConcurrentTree::collectHelper(const Node* cur,
+								   vector<const NodeData*>& sorted) {
+	if (cur != NULL) {
+		collectHelper(cur->left, sorted);
+		sorted.push_back(cur->data);
+		collectHelper(cur->right, sorted);
+	}
+}
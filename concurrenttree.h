@@ -0,0 +1,245 @@
+//-----------------------------------------------------------------------//
+// CONCURRENTTREE.H                                                      //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// ConcurrentTree is an AVL tree of strings that many threads can read   //
+// without locks while other threads insert                              //
+//-----------------------------------------------------------------------//
+// Snapshot publishing:  a published Node is never changed.  An insert   //
+//       copies the Nodes on its search path, links the copies to the    //
+//       untouched subtrees, and publishes the new root with one atomic  //
+//       store.  A reader loads the root once and sees a consistent      //
+//       version of the tree for as long as it walks it.                 //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- keys are spread over one or more shards by NodeData::hash; each  //
+//      shard is its own AVL tree with its own writer mutex, so writers  //
+//      on different shards insert in parallel.  Readers never lock      //
+//   -- with one shard (the default) getDepth is the depth in the whole  //
+//      tree; with more it is the depth within the key's shard           //
+//   -- the Nodes an insert replaces are retired, and deleted once no    //
+//      reader can still be walking a version that contains them         //
+//      (epoch based reclamation):                                       //
+//        -- a reader pins the current epoch in a reader slot before it  //
+//           loads the root, and clears the slot when it is done         //
+//        -- the epoch only advances when every pinned slot holds the    //
+//           current epoch, so a Node retired in epoch e is unreachable  //
+//           to every reader once the epoch reaches e + 2                //
+//   -- NodeDatas are shared by every version and deleted with the tree  //
+//   -- the tree cannot be copied                                        //
+//-----------------------------------------------------------------------//
+
+#ifndef CONCURRENTTREE_H
+#define CONCURRENTTREE_H
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <cstddef>
+#include "nodedata.h"
+using namespace std;
+
+
+class ConcurrentTree {
+//-----------------------------  <<  --------------------------------------
+// Overloaded output operator for class ConcurrentTree
+// Preconditions:   NodeData has a working output operator overload
+// Postconditions:  prints an in order traversal of the published
+//       versions of the shards, merged
+friend ostream& operator<<(ostream&, const ConcurrentTree&);
+
+public:
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class ConcurrentTree
+// Preconditions:   none
+// Postconditions:
+//       -- a tree of size 0 is created
+ConcurrentTree();
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the number of shards; more shards let more
+// writers insert at once
+// Preconditions:   the int is at least 1
+// Postconditions:
+//       -- a tree of size 0 is created
+explicit ConcurrentTree(int);
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class ConcurrentTree
+// Preconditions:   no thread is using the tree
+// Postconditions:
+//       -- all Nodes, retired Nodes and NodeDatas are deallocated
+~ConcurrentTree();
+
+//------------------------------ insert -----------------------------------
+// Add a NodeData to the tree and publish the new version, returns true if
+// successful.  No duplicate NodeDatas are allowed
+// Preconditions:   none; safe to call from any thread, locks the shard
+//       the NodeData hashes to
+// Postconditions:
+//       -- the NodeData is owned by the tree if true is returned; readers
+//          that start after insert returns will find it
+bool insert(NodeData*);
+
+//---------------------------- retrieve -----------------------------------
+// Retrieve a NodeData* of a given object in the tree, return true if found
+// Preconditions:   none; safe to call from any thread, takes no lock
+// Postconditions:
+//       -- the second parameter points to the found object.  If object
+//          is not found, no reassignment of ptr is made
+bool retrieve(const NodeData&, NodeData*&) const;
+
+//------------------------------ getDepth ---------------------------------
+// Returns the depth of a given value in the published tree, the root
+// being 1, or 0 if it is not in the tree
+// Preconditions:   none; safe to call from any thread, takes no lock
+// Postconditions:  none
+int getDepth(const NodeData&) const;
+
+//-------------------------------- size -----------------------------------
+// Returns the number of NodeDatas in the published tree, summed over the
+// shards
+// Preconditions:   none; safe to call from any thread, takes no lock
+// Postconditions:  none
+int size() const;
+
+//----------------------------- isEmpty -----------------------------------
+// Returns true if the published tree has no Nodes
+// Preconditions:   none; safe to call from any thread, takes no lock
+// Postconditions:  none
+bool isEmpty() const;
+
+private:
+ConcurrentTree(const ConcurrentTree&);            //not copyable
+ConcurrentTree& operator=(const ConcurrentTree&); //not assignable
+
+static const int READERSLOTS = 64; //reader slots, one per concurrent reader
+
+struct Node {
+	NodeData* data;   //pointer to data object, shared by every version
+	Node* left;       //left subtree pointer
+	Node* right;      //right subtree pointer
+	int height;       //height of the subtree rooted here, a leaf is 1
+	int size;         //number of Nodes in the subtree rooted here
+};
+
+struct Retired {
+	Node* node;              //unlinked Node waiting to be deleted
+	unsigned long epoch;     //epoch it was unlinked in
+};
+
+struct alignas(64) ReaderSlot {  //one cache line each, so readers on
+	atomic<unsigned long> epoch; //different slots never share a line;
+};                               //0 means no reader
+
+struct alignas(64) Shard {       //one writer at a time per shard
+	atomic<Node*> root;          //published version of the shard
+	mutex writeLock;             //serializes the shard's writers
+	vector<Retired> retired;     //Nodes unlinked but maybe still read
+};
+
+Shard* shards;                    //shards the keys are hashed over
+int shardCount;                   //number of shards
+atomic<unsigned long> epoch;      //global epoch, starts at 1
+mutable ReaderSlot slots[READERSLOTS]; //epochs pinned by readers
+
+//----------------------------  ReadGuard  --------------------------------
+// pins the current epoch in a free reader slot for as long as it lives;
+// the thread's last slot is tried first, so a reader usually pins with
+// one uncontended compare and swap
+class ReadGuard {
+public:
+	explicit ReadGuard(const ConcurrentTree&);
+	~ReadGuard();
+private:
+	ReadGuard(const ReadGuard&);
+	ReadGuard& operator=(const ReadGuard&);
+	ReaderSlot* slot;  //slot holding this reader's epoch
+};
+
+//----------------------------  createNode  -------------------------------
+// allocates a Node with the children passed and computes its height and
+// size from them
+// Preconditions:   none
+// Postconditions:  returns the new, not yet published Node
+static Node* createNode(NodeData*, Node*, Node*);
+
+//-----------------------------  heightOf  --------------------------------
+// returns the height of the subtree passed, 0 for an empty subtree
+// Preconditions:   none
+// Postconditions:  none
+static int heightOf(const Node*);
+
+//------------------------------  sizeOf  ---------------------------------
+// returns the number of Nodes in the subtree passed
+// Preconditions:   none
+// Postconditions:  none
+static int sizeOf(const Node*);
+
+//----------------------------  updateNode  -------------------------------
+// recomputes the height and size of a Node from those of its children
+// Preconditions:   the Node is not yet published
+// Postconditions:  the Node's height and size are correct
+static void updateNode(Node*);
+
+//----------------------------  rotateLeft  -------------------------------
+// rotates a subtree left and returns its new root
+// Preconditions:   the subtree root and its right child are unpublished
+// Postconditions:  in order sequence is unchanged, heights and sizes
+//			are correct
+static Node* rotateLeft(Node*);
+
+//----------------------------  rotateRight  ------------------------------
+// rotates a subtree right and returns its new root
+// Preconditions:   the subtree root and its left child are unpublished
+// Postconditions:  in order sequence is unchanged, heights and sizes
+//			are correct
+static Node* rotateRight(Node*);
+
+//----------------------------  balanced  ---------------------------------
+// builds the Node for a key over two subtrees, rotating so that the AVL
+// property holds.  Only Nodes this insert created are rotated, since the
+// heavy side of an AVL insert is always the side it went down
+// Preconditions:   the subtree heights differ by at most 2
+// Postconditions:  returns the root of the balanced subtree
+static Node* balanced(NodeData*, Node*, Node*);
+
+//---------------------------  insertHelper  ------------------------------
+// recursive helper for insert; returns the root of a new version of the
+// subtree holding the NodeData, sharing every subtree off the path with
+// the old version
+// Preconditions:   the shard's writer lock is held
+// Postconditions:  the replaced Nodes are appended to the vector; returns
+//			the old subtree unchanged if the NodeData is a duplicate
+Node* insertHelper(Node*, NodeData*, bool&, vector<Node*>&);
+
+//----------------------------  shardFor  ---------------------------------
+// returns the shard a NodeData hashes to
+// Preconditions:   none
+// Postconditions:  none
+Shard& shardFor(const NodeData&) const;
+
+//-----------------------------  reclaim  ---------------------------------
+// advances the epoch if every pinned reader is in the current one, then
+// deletes the shard's retired Nodes no reader can reach any more
+// Preconditions:   the shard's writer lock is held
+// Postconditions:  none
+void reclaim(Shard&);
+
+//----------------------------  collectHelper  ----------------------------
+// recursive helper for operator<<; appends a shard's NodeDatas in order
+// Preconditions:   the caller holds a ReadGuard
+// Postconditions:  none
+static void collectHelper(const Node*, vector<const NodeData*>&);
+
+//---------------------------  deleteSubtree  -----------------------------
+// recursive helper for the destructor; deletes the Nodes and NodeDatas
+// Preconditions:   no reader is walking the subtree
+// Postconditions:  none
+static void deleteSubtree(Node*);
+
+};
+
+#endif
@@ -0,0 +1,168 @@
+//-----------------------------------------------------------------------//
+// FROZENTREE.CPP                                                        //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// FrozenTree is a read-only snapshot of a BinTree, laid out in one array//
+//-----------------------------------------------------------------------//
+// Eytzinger layout:  the keys are stored in breadth first order of a    //
+//       complete tree, so the children of slot k are slots 2k and 2k+1. //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- the 8 keyPrefixes three levels below slot k are slots 8k to 8k+7,//
+//      line k of prefixes, which find prefetches while it compares      //
+//-----------------------------------------------------------------------//
+
+#include "frozentree.h"
+
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class FrozenTree
+// Preconditions:   none
+// Postconditions:
+//       -- an empty snapshot is created
+FrozenTree::FrozenTree() : keys(1), prefixes(1, PrefixLine()),
+						   depths(1, 0) {
+}
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the NodeDatas of a tree in order, and the depth
+// each one had in that tree
+// Preconditions:   the NodeDatas are sorted and distinct, both vectors
+//       are the same length
+// Postconditions:
+//       -- the snapshot holds copies of the NodeDatas
+FrozenTree::FrozenTree(const vector<NodeData*>& sorted,
+					   const vector<int>& sortedDepths)
+	: keys(sorted.size() + 1),
+	  prefixes(sorted.size() / LINESLOTS + 1, PrefixLine()),
+	  depths(sorted.size() + 1, 0) {
+	int index = 0;
+	fillSlots(sorted, sortedDepths, index, 1);
+}
+
+//----------------------------  fillSlots  --------------------------------
+// recursive helper for the constructor; places the sorted NodeDatas into
+// the slots by an inorder traversal of the implicit tree
+// Preconditions:   index starts at 0, slot at 1
+// Postconditions:  every slot in the subtree is filled
+void FrozenTree::fillSlots(const vector<NodeData*>& sorted,
+						   const vector<int>& sortedDepths, int& index,
+						   int slot) {
+	if (slot <= size()) {
+		fillSlots(sorted, sortedDepths, index, 2 * slot);
+		keys[slot] = *sorted[index];
+		prefixOf(slot) = keys[slot].keyPrefix();
+		depths[slot] = sortedDepths[index];
+		index++;
+		fillSlots(sorted, sortedDepths, index, 2 * slot + 1);
+	}
+}
+
+//----------------------------- isEmpty -----------------------------------
+// Returns true if the snapshot holds no NodeDatas
+// Preconditions:   none
+// Postconditions:  none
+bool FrozenTree::isEmpty() const {
+	return size() == 0;
+}
+
+//-------------------------------- size -----------------------------------
+// Returns the number of NodeDatas in the snapshot
+// Preconditions:   none
+// Postconditions:  none
+int FrozenTree::size() const {
+	return (int)keys.size() - 1; //slot 0 is unused
+}
+
+//---------------------------- retrieve -----------------------------------
+// Retrieve a NodeData* of a given object in the snapshot, return true if
+// found
+// Preconditions:   none
+// Postconditions:  the second parameter points to the snapshot's copy if
+//       found; no reassignment of ptr is made otherwise
+bool FrozenTree::retrieve(const NodeData& toFind,
+						  const NodeData*& ptr) const {
+	int slot = find(toFind);
+	if (slot == 0)
+		return false;
+	ptr = &keys[slot];
+	return true;
+}
+
+//------------------------------ getDepth ---------------------------------
+// Returns the depth the object had in the frozen BinTree, 0 if absent
+// Preconditions:   none
+// Postconditions:  none
+int FrozenTree::getDepth(const NodeData& toFind) const {
+	return depths[find(toFind)]; //slot 0 holds depth 0
+}
+
+//-----------------------------  prefixOf  --------------------------------
+// returns the keyPrefix kept for a slot
+// Preconditions:   the slot is in 0 to size()
+// Postconditions:  none
+unsigned long long& FrozenTree::prefixOf(int slot) {
+	return prefixes[slot / LINESLOTS].prefix[slot % LINESLOTS];
+}
+
+const unsigned long long& FrozenTree::prefixOf(int slot) const {
+	return prefixes[slot / LINESLOTS].prefix[slot % LINESLOTS];
+}
+
+//------------------------------  find  -----------------------------------
+// branchless search: descends to the bottom of the tree one level per
+// step, picking the child with arithmetic rather than a branch, then
+// backs up to the last slot whose key was not less than the object
+// Preconditions:   none
+// Postconditions:  returns the object's slot, or 0 if it is absent
+int FrozenTree::find(const NodeData& toFind) const {
+	int count = size();
+	unsigned long long prefix = toFind.keyPrefix();
+	int slot = 1;
+	while (slot <= count) {
+#ifdef __GNUC__
+		if (8 * slot <= count) //slots 8 * slot on, three levels down
+			__builtin_prefetch(&prefixes[slot]);
+#endif
+		bool less = prefixOf(slot) < prefix;
+		if (prefixOf(slot) == prefix) //only then look at the strings
+			less = keys[slot] < toFind;
+		slot = 2 * slot + less;
+	}
+	while (slot & 1) //undo the right turns after the last left turn
+		slot >>= 1;
+	slot >>= 1; //and the left turn itself
+	if (slot == 0 || prefixOf(slot) != prefix || keys[slot] != toFind)
+		return 0;
+	return slot;
+}
+
+//-----------------------------  <<  --------------------------------------
+// Overloaded output operator for class FrozenTree
+// Preconditions:   NodeData has a working output operator overload
+// Postconditions:  prints an in order traversal, formatted as BinTree's
+ostream& operator<<(ostream& out, const FrozenTree& toPrint) {
+	if (toPrint.isEmpty()) {
+		out << "Empty" << endl;
+		return out;
+	} else {
+		toPrint.inorderHelper(out, 1);
+		out << endl;
+		return out;
+	}
+}
+
+//---------------------------  inorderHelper  -----------------------------
+// recursive helper for operator<<; puts the keys of a subtree on the
+// stream in order
+// Preconditions:   the root slot (1) is passed
+// Postconditions:  none
+ostream& FrozenTree::inorderHelper(ostream& out, int slot) const {
+	if (slot <= size()) {
+		inorderHelper(out, 2 * slot);
+		out << " " << keys[slot];
+		inorderHelper(out, 2 * slot + 1);
+	}
+	return out;
+}
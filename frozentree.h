@@ -0,0 +1,126 @@
+//-----------------------------------------------------------------------//
+// FROZENTREE.H                                                          //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// FrozenTree is a read-only snapshot of a BinTree, laid out in one array//
+//-----------------------------------------------------------------------//
+// Eytzinger layout:  the keys are stored in breadth first order of a    //
+//       complete tree, so the children of slot k are slots 2k and 2k+1. //
+//       A search touches the array front to back, and the next few      //
+//       levels can be prefetched before they are needed.                //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- made by BinTree::freeze(); never changes afterwards              //
+//   -- slot 0 is unused so the root is slot 1                           //
+//   -- every slot keeps the 8 byte keyPrefix of its key next to the     //
+//      others, so most levels are decided by one integer comparison     //
+//      without touching the string.  The prefixes are kept in 64 byte   //
+//      aligned lines of 8, so slots 8k to 8k+7 share one cache line     //
+//   -- getDepth answers the depth the key had in the BinTree it was     //
+//      frozen from, not its depth in the array                          //
+//-----------------------------------------------------------------------//
+
+#ifndef FROZENTREE_H
+#define FROZENTREE_H
+#include <iostream>
+#include <vector>
+#include "nodedata.h"
+using namespace std;
+
+
+class FrozenTree {
+//-----------------------------  <<  --------------------------------------
+// Overloaded output operator for class FrozenTree
+// Preconditions:   NodeData has a working output operator overload
+// Postconditions:  prints an in order traversal, formatted as BinTree's
+friend ostream& operator<<(ostream&, const FrozenTree&);
+
+public:
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class FrozenTree
+// Preconditions:   none
+// Postconditions:
+//       -- an empty snapshot is created
+FrozenTree();
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the NodeDatas of a tree in order, and the depth
+// each one had in that tree
+// Preconditions:   the NodeDatas are sorted and distinct, both vectors
+//       are the same length
+// Postconditions:
+//       -- the snapshot holds copies of the NodeDatas
+FrozenTree(const vector<NodeData*>&, const vector<int>&);
+
+//----------------------------- isEmpty -----------------------------------
+// Returns true if the snapshot holds no NodeDatas
+// Preconditions:   none
+// Postconditions:  none
+bool isEmpty() const;
+
+//-------------------------------- size -----------------------------------
+// Returns the number of NodeDatas in the snapshot
+// Preconditions:   none
+// Postconditions:  none
+int size() const;
+
+//---------------------------- retrieve -----------------------------------
+// Retrieve a NodeData* of a given object in the snapshot, return true if
+// found
+// Preconditions:   none
+// Postconditions:  the second parameter points to the snapshot's copy if
+//       found; no reassignment of ptr is made otherwise
+bool retrieve(const NodeData&, const NodeData*&) const;
+
+//------------------------------ getDepth ---------------------------------
+// Returns the depth the object had in the frozen BinTree, 0 if absent
+// Preconditions:   none
+// Postconditions:  none
+int getDepth(const NodeData&) const;
+
+private:
+static const int LINESLOTS = 8;       //prefixes in a cache line
+
+struct PrefixLine {                   //one cache line of prefixes
+	alignas(64) unsigned long long prefix[LINESLOTS];
+};
+
+vector<NodeData> keys;                //keys, slot k's children at 2k, 2k+1
+vector<PrefixLine> prefixes;          //keyPrefix of each slot's key, slot
+                                      //k's in line k / LINESLOTS
+vector<int> depths;                   //depth of each slot's key in BinTree
+
+//-----------------------------  prefixOf  --------------------------------
+// returns the keyPrefix kept for a slot
+// Preconditions:   the slot is in 0 to size()
+// Postconditions:  none
+unsigned long long& prefixOf(int);
+const unsigned long long& prefixOf(int) const;
+
+//------------------------------  find  -----------------------------------
+// branchless search: descends to the bottom of the tree one level per
+// step, picking the child with arithmetic rather than a branch, then
+// backs up to the last slot whose key was not less than the object
+// Preconditions:   none
+// Postconditions:  returns the object's slot, or 0 if it is absent
+int find(const NodeData&) const;
+
+//----------------------------  fillSlots  --------------------------------
+// recursive helper for the constructor; places the sorted NodeDatas into
+// the slots by an inorder traversal of the implicit tree
+// Preconditions:   index starts at 0, slot at 1
+// Postconditions:  every slot in the subtree is filled
+void fillSlots(const vector<NodeData*>&, const vector<int>&, int&, int);
+
+//---------------------------  inorderHelper  -----------------------------
+// recursive helper for operator<<; puts the keys of a subtree on the
+// stream in order
+// Preconditions:   the root slot (1) is passed
+// Postconditions:  none
+ostream& inorderHelper(ostream&, int) const;
+
+};
+
+#endif
@@ -105,12 +105,11 @@ void buildTree(BinTree& T, ifstream& infile) {
       cout << s << ' ';
       if (s == "$$") break;                // at end of one line
       if (infile.eof()) break;             // no more lines of data
-      NodeData* ptr = new NodeData(s);     // NodeData constructor takes string
+      NodeData key(s);                     // NodeData constructor takes string
       // would do a setData if there were more than a string
 
-      bool success = T.insert(ptr);   
-      if (!success)
-         delete ptr;                       // duplicate case, not inserted 
+      NodeData* found;                     // copied into the tree only if
+      T.findOrInsert(key, found);          // new, so duplicates cost nothing
    }
 }
 
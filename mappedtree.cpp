@@ -0,0 +1,282 @@
+//-----------------------------------------------------------------------//
+// MAPPEDTREE.CPP                                                        //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// MappedTree is a read-only tree of strings queried in place from a     //
+// file written by BinTree::save                                         //
+//-----------------------------------------------------------------------//
+// File layout:  header, keyPrefixes, Slots, pool; see mappedtree.h.     //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- every section starts 8 byte aligned, so the mapped file is read  //
+//      through plain pointers into it.  The header takes 64 bytes, so   //
+//      the prefixes start on a cache line of the page aligned mapping   //
+//      and each 8 that find prefetches, slots 8k to 8k+7, fill one line //
+//   -- open only accepts a file whose length is exactly what its header //
+//      says, so a file cut short by a failed save is refused            //
+//-----------------------------------------------------------------------//
+
+#include "mappedtree.h"
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static const char MAGIC[8] = "BINTREE"; //first bytes of every file
+
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class MappedTree
+// Preconditions:   none
+// Postconditions:
+//       -- an empty tree with no file is created
+MappedTree::MappedTree() {
+	mapping = NULL;
+	mappedBytes = 0;
+	count = 0;
+	prefixes = NULL;
+	slots = NULL;
+	pool = NULL;
+}
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class MappedTree
+// Preconditions:   none
+// Postconditions:
+//       -- the file is unmapped
+MappedTree::~MappedTree() {
+	close();
+}
+
+//-------------------------------- open -----------------------------------
+// Maps a file written by BinTree::save, returns true if successful.  The
+// header is checked, and the file's length against the sections it
+// declares; the keys themselves are not read
+// Preconditions:   the file is not changed while it is mapped
+// Postconditions:  the tree answers queries from the file; on false it
+//       is empty
+bool MappedTree::open(const char* path) {
+	close();
+	int file = ::open(path, O_RDONLY);
+	if (file < 0)
+		return false;
+	struct stat status;
+	if (fstat(file, &status) != 0 ||
+		(size_t)status.st_size < sizeof(Header)) {
+		::close(file);
+		return false;
+	}
+	size_t bytes = (size_t)status.st_size;
+	void* mapped = mmap(NULL, bytes, PROT_READ, MAP_SHARED, file, 0);
+	::close(file); //the mapping keeps the file open
+	if (mapped == MAP_FAILED)
+		return false;
+	const Header* header = (const Header*)mapped;
+	uint64_t slotCount = header->count + 1;
+	bool valid = memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 &&
+				 header->byteOrder == BYTEORDER &&
+				 header->count < (uint64_t)INT32_MAX &&
+				 header->poolBytes <= bytes &&
+				 sizeof(Header) + slotCount * sizeof(uint64_t) +
+				 slotCount * sizeof(Slot) + header->poolBytes == bytes;
+	if (!valid) {
+		munmap(mapped, bytes);
+		return false;
+	}
+	mapping = mapped;
+	mappedBytes = bytes;
+	count = (int)header->count;
+	const char* base = (const char*)mapped;
+	prefixes = (const uint64_t*)(base + sizeof(Header));
+	slots = (const Slot*)(prefixes + slotCount);
+	pool = (const char*)(slots + slotCount);
+	return true;
+}
+
+//------------------------------- close -----------------------------------
+// Unmaps the file, if one is open
+// Preconditions:   none
+// Postconditions:  the tree is empty
+void MappedTree::close() {
+	if (mapping != NULL)
+		munmap(mapping, mappedBytes);
+	mapping = NULL;
+	mappedBytes = 0;
+	count = 0;
+	prefixes = NULL;
+	slots = NULL;
+	pool = NULL;
+}
+
+//-------------------------------- write ----------------------------------
+// Writes the NodeDatas of a tree in order, and the depth each one had in
+// it, to a file open can map; the sections are built in memory and
+// written with one call each
+// Preconditions:   the NodeDatas are sorted and distinct, both vectors
+//       are the same length
+// Postconditions:  the file is replaced
+bool MappedTree::write(const char* path, const vector<NodeData*>& sorted,
+					   const vector<int>& depths) {
+	vector<uint64_t> slotPrefixes(sorted.size() + 1, 0);
+	vector<Slot> slotKeys(sorted.size() + 1);
+	memset(&slotKeys[0], 0, slotKeys.size() * sizeof(Slot));
+	string characters;
+	int index = 0;
+	placeKeys(sorted, depths, index, 1, slotPrefixes, slotKeys,
+			  characters);
+	Header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.byteOrder = BYTEORDER;
+	header.count = sorted.size();
+	header.poolBytes = characters.size();
+	ofstream out(path, ios::binary | ios::trunc);
+	out.write((const char*)&header, sizeof(header));
+	out.write((const char*)&slotPrefixes[0],
+			  slotPrefixes.size() * sizeof(uint64_t));
+	out.write((const char*)&slotKeys[0], slotKeys.size() * sizeof(Slot));
+	out.write(characters.data(), characters.size());
+	out.close();
+	return !out.fail();
+}
+
+//-----------------------------  placeKeys  -------------------------------
+// recursive helper for write; places the sorted NodeDatas into the slots
+// by an inorder traversal of the implicit tree, appending each one's
+// characters to the pool
+// Preconditions:   index starts at 0, slot at 1
+// Postconditions:  every slot in the subtree is filled
+void MappedTree::placeKeys(const vector<NodeData*>& sorted,
+						   const vector<int>& depths, int& index, int slot,
+						   vector<uint64_t>& slotPrefixes,
+						   vector<Slot>& slotKeys, string& characters) {
+	if (slot < (int)slotKeys.size()) {
+		placeKeys(sorted, depths, index, 2 * slot, slotPrefixes, slotKeys,
+				  characters);
+		const NodeData& key = *sorted[index];
+		slotPrefixes[slot] = key.keyPrefix();
+		slotKeys[slot].offset = characters.size();
+		slotKeys[slot].length = (uint32_t)key.length();
+		slotKeys[slot].depth = depths[index];
+		characters.append(key.chars(), key.length());
+		index++;
+		placeKeys(sorted, depths, index, 2 * slot + 1, slotPrefixes,
+				  slotKeys, characters);
+	}
+}
+
+//----------------------------- isEmpty -----------------------------------
+// Returns true if the tree holds no keys
+// Preconditions:   none
+// Postconditions:  none
+bool MappedTree::isEmpty() const {
+	return count == 0;
+}
+
+//-------------------------------- size -----------------------------------
+// Returns the number of keys in the tree
+// Preconditions:   none
+// Postconditions:  none
+int MappedTree::size() const {
+	return count;
+}
+
+//----------------------------- contains ----------------------------------
+// Returns true if an object equal to the parameter is in the tree
+// Preconditions:   none
+// Postconditions:  none
+bool MappedTree::contains(const NodeData& toFind) const {
+	return find(toFind) != 0;
+}
+
+//------------------------------ getDepth ---------------------------------
+// Returns the depth the object had in the saved BinTree, 0 if absent
+// Preconditions:   none
+// Postconditions:  none
+int MappedTree::getDepth(const NodeData& toFind) const {
+	int slot = find(toFind);
+	return slot == 0 ? 0 : slots[slot].depth;
+}
+
+//------------------------------  find  -----------------------------------
+// branchless search, as FrozenTree's: descends to the bottom of the tree
+// one level per step, picking the child with arithmetic rather than a
+// branch, then backs up to the last slot whose key was not less than the
+// object.  The slot is 64 bit: it reaches twice count at the bottom,
+// and the prefetch looks eight times as far, past any int in a large
+// file
+// Preconditions:   none
+// Postconditions:  returns the object's slot, or 0 if it is absent
+int MappedTree::find(const NodeData& toFind) const {
+	unsigned long long prefix = toFind.keyPrefix();
+	uint64_t slot = 1;
+	while (slot <= (uint64_t)count) {
+#ifdef __GNUC__
+		if (8 * slot <= (uint64_t)count)
+			__builtin_prefetch(&prefixes[8 * slot]);
+#endif
+		bool less = prefixes[slot] < prefix;
+		if (prefixes[slot] == prefix) //only then look at the characters
+			less = compareAt((int)slot, toFind) < 0;
+		slot = 2 * slot + less;
+	}
+	while (slot & 1) //undo the right turns after the last left turn
+		slot >>= 1;
+	slot >>= 1; //and the left turn itself
+	if (slot == 0 || prefixes[slot] != prefix ||
+		compareAt((int)slot, toFind) != 0)
+		return 0;
+	return (int)slot;
+}
+
+//----------------------------  compareAt  --------------------------------
+// three way comparison of a slot's key with the object, in place; bytes
+// compare as unsigned, as string::compare does
+// Preconditions:   the slot holds a key
+// Postconditions:  negative, zero or positive as the key is less than,
+//			equal to or greater than the object
+int MappedTree::compareAt(int slot, const NodeData& toFind) const {
+	size_t length = slots[slot].length;
+	size_t shorter = min(length, toFind.length());
+	int order = memcmp(pool + slots[slot].offset, toFind.chars(), shorter);
+	if (order != 0)
+		return order;
+	if (length == toFind.length())
+		return 0;
+	return length < toFind.length() ? -1 : 1;
+}
+
+//-----------------------------  <<  --------------------------------------
+// Overloaded output operator for class MappedTree
+// Preconditions:   none
+// Postconditions:  prints an in order traversal, formatted as BinTree's
+ostream& operator<<(ostream& out, const MappedTree& toPrint) {
+	if (toPrint.isEmpty()) {
+		out << "Empty" << endl;
+		return out;
+	} else {
+		toPrint.inorderHelper(out, 1);
+		out << endl;
+		return out;
+	}
+}
+
+//---------------------------  inorderHelper  -----------------------------
+// recursive helper for operator<<; puts the keys of a subtree on the
+// stream in order, straight from the pool; the slot is 64 bit, as in
+// find, since the children of the last slots lie past any int
+// Preconditions:   the root slot (1) is passed
+// Postconditions:  none
+ostream& MappedTree::inorderHelper(ostream& out, uint64_t slot) const {
+	if (slot <= (uint64_t)count) {
+		inorderHelper(out, 2 * slot);
+		out << " ";
+		out.write(pool + slots[slot].offset, slots[slot].length);
+		inorderHelper(out, 2 * slot + 1);
+	}
+	return out;
+}
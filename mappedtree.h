@@ -0,0 +1,171 @@
+//-----------------------------------------------------------------------//
+// MAPPEDTREE.H                                                          //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// MappedTree is a read-only tree of strings queried in place from a     //
+// file written by BinTree::save                                         //
+//-----------------------------------------------------------------------//
+// File layout:  a header, then the keyPrefix of every slot, then one    //
+//       Slot per key, then a pool holding the characters of every key   //
+//       back to back.  The slots are in Eytzinger order, as in          //
+//       FrozenTree, so the children of slot k are slots 2k and 2k+1 and //
+//       no links are stored; a Slot finds its characters by their       //
+//       offset from the start of the pool.                              //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- open maps the file with mmap and checks its header and size      //
+//      against each other; nothing is read, parsed or allocated per     //
+//      key, so opening takes the same time for any size of tree, and    //
+//      the pages a search touches are read in by the kernel on demand   //
+//   -- the file holds integers in the byte order of the machine that    //
+//      wrote it; open refuses a file written in the other order         //
+//   -- the Slots of a file are trusted to be the ones save wrote        //
+//   -- slot 0 is unused so the root is slot 1                           //
+//   -- getDepth answers the depth the key had in the BinTree that was   //
+//      saved                                                            //
+//   -- the tree cannot be copied; POSIX only                            //
+//-----------------------------------------------------------------------//
+
+#ifndef MAPPEDTREE_H
+#define MAPPEDTREE_H
+#include <iostream>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "nodedata.h"
+using namespace std;
+
+
+class MappedTree {
+//-----------------------------  <<  --------------------------------------
+// Overloaded output operator for class MappedTree
+// Preconditions:   none
+// Postconditions:  prints an in order traversal, formatted as BinTree's
+friend ostream& operator<<(ostream&, const MappedTree&);
+
+public:
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class MappedTree
+// Preconditions:   none
+// Postconditions:
+//       -- an empty tree with no file is created
+MappedTree();
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class MappedTree
+// Preconditions:   none
+// Postconditions:
+//       -- the file is unmapped
+~MappedTree();
+
+//-------------------------------- open -----------------------------------
+// Maps a file written by BinTree::save, returns true if successful
+// Preconditions:   the file is not changed while it is mapped
+// Postconditions:  the tree answers queries from the file; on false it
+//       is empty
+bool open(const char*);
+
+//------------------------------- close -----------------------------------
+// Unmaps the file, if one is open
+// Preconditions:   none
+// Postconditions:  the tree is empty
+void close();
+
+//-------------------------------- write ----------------------------------
+// Writes the NodeDatas of a tree in order, and the depth each one had in
+// it, to a file open can map; returns true if successful
+// Preconditions:   the NodeDatas are sorted and distinct, both vectors
+//       are the same length
+// Postconditions:  the file is replaced
+static bool write(const char*, const vector<NodeData*>&,
+				  const vector<int>&);
+
+//----------------------------- isEmpty -----------------------------------
+// Returns true if the tree holds no keys
+// Preconditions:   none
+// Postconditions:  none
+bool isEmpty() const;
+
+//-------------------------------- size -----------------------------------
+// Returns the number of keys in the tree
+// Preconditions:   none
+// Postconditions:  none
+int size() const;
+
+//----------------------------- contains ----------------------------------
+// Returns true if an object equal to the parameter is in the tree
+// Preconditions:   none
+// Postconditions:  none
+bool contains(const NodeData&) const;
+
+//------------------------------ getDepth ---------------------------------
+// Returns the depth the object had in the saved BinTree, 0 if absent
+// Preconditions:   none
+// Postconditions:  none
+int getDepth(const NodeData&) const;
+
+private:
+MappedTree(const MappedTree&);            //not copyable
+MappedTree& operator=(const MappedTree&); //not assignable
+
+static const uint32_t BYTEORDER = 0x01020304; //reads back swapped if the
+											  //file's order differs
+
+struct Header {
+	char magic[8];       //"BINTREE" and a NUL
+	uint32_t byteOrder;  //BYTEORDER, as the writer stored it
+	uint32_t unused;     //keeps the counts 8 byte aligned
+	uint64_t count;      //keys in the file
+	uint64_t poolBytes;  //characters in the pool
+	char padding[32];    //zeros, so the prefixes start on a cache line
+};
+
+struct Slot {
+	uint64_t offset;     //where the key's characters start in the pool
+	uint32_t length;     //how many there are
+	int32_t depth;       //depth of the key in the saved BinTree
+};
+
+void* mapping;              //the mapped file, or NULL
+size_t mappedBytes;         //its length
+int count;                  //keys in the tree
+const uint64_t* prefixes;   //keyPrefix of each slot's key
+const Slot* slots;          //each slot's key
+const char* pool;           //every key's characters
+
+//------------------------------  find  -----------------------------------
+// branchless search, as FrozenTree's: descends to the bottom of the tree
+// one level per step, then backs up to the last slot whose key was not
+// less than the object
+// Preconditions:   none
+// Postconditions:  returns the object's slot, or 0 if it is absent
+int find(const NodeData&) const;
+
+//----------------------------  compareAt  --------------------------------
+// three way comparison of a slot's key with the object, in place
+// Preconditions:   the slot holds a key
+// Postconditions:  negative, zero or positive as the key is less than,
+//			equal to or greater than the object
+int compareAt(int, const NodeData&) const;
+
+//-----------------------------  placeKeys  -------------------------------
+// recursive helper for write; places the sorted NodeDatas into the slots
+// by an inorder traversal of the implicit tree, appending each one's
+// characters to the pool
+// Preconditions:   index starts at 0, slot at 1
+// Postconditions:  every slot in the subtree is filled
+static void placeKeys(const vector<NodeData*>&, const vector<int>&, int&,
+					  int, vector<uint64_t>&, vector<Slot>&, string&);
+
+//---------------------------  inorderHelper  -----------------------------
+// recursive helper for operator<<; puts the keys of a subtree on the
+// stream in order
+// Preconditions:   the root slot (1) is passed
+// Postconditions:  none
+ostream& inorderHelper(ostream&, uint64_t) const;
+
+};
+
+#endif
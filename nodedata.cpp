@@ -1,4 +1,7 @@
 #include "nodedata.h"
+#include <functional>
+#include <algorithm>
+#include <cstring>
 
 //------------------- constructors/destructor  -------------------------------
 NodeData::NodeData() { data = ""; }                         // default
@@ -17,30 +20,53 @@ NodeData& NodeData::operator=(const NodeData& rhs) {
    return *this;
 }
 
-//------------------------- operator==,!= ------------------------------------
-virtual bool NodeData::operator==(const NodeData& rhs) const {
-   return data == rhs.data;
-}
+//------------------------------ keyPrefix -----------------------------------
+// first 8 bytes of data packed big endian, zero padded; equal prefixes
+// still need a full comparison
 
-bool NodeData::operator!=(const NodeData& rhs) const {
-   return data != rhs.data;
+unsigned long long NodeData::keyPrefix() const {
+   unsigned long long prefix = 0;
+   for (size_t i = 0; i < 8; i++) {
+      prefix <<= 8;
+      if (i < data.size())
+         prefix |= (unsigned char)data[i];
+   }
+   return prefix;
 }
 
-//------------------------ operator<,>,<=,>= ---------------------------------
-virtual bool NodeData::operator<(const NodeData& rhs) const {
-   return data < rhs.data;
-}
+//------------------------------ compare -------------------------------------
+// three way comparison starting at skip; the characters before skip are
+// assumed equal, so keys with long shared prefixes are not rescanned
 
-bool NodeData::operator>(const NodeData& rhs) const {
-   return data > rhs.data;
+int NodeData::compare(const NodeData& rhs, size_t skip,
+                      size_t& common) const {
+   size_t shorter = min(data.size(), rhs.data.size());
+   size_t i = min(skip, shorter);
+   const char* lhsChars = data.data();
+   const char* rhsChars = rhs.data.data();
+   while (i + 8 <= shorter) {  // 8 characters at a time
+      unsigned long long lhsWord, rhsWord;
+      memcpy(&lhsWord, lhsChars + i, 8);
+      memcpy(&rhsWord, rhsChars + i, 8);
+      if (lhsWord != rhsWord)
+         break;
+      i += 8;
+   }
+   while (i < shorter && lhsChars[i] == rhsChars[i])
+      i++;
+   common = i;
+   if (i < shorter)
+      return (unsigned char)data[i] < (unsigned char)rhs.data[i] ? -1 : 1;
+   if (data.size() == rhs.data.size())
+      return 0;
+   return data.size() < rhs.data.size() ? -1 : 1;
 }
 
-bool NodeData::operator<=(const NodeData& rhs) const {
-   return data <= rhs.data;
-}
+//-------------------------------- hash --------------------------------------
+// hash of data; equal NodeDatas have equal hashes
 
-bool NodeData::operator>=(const NodeData& rhs) const {
-   return data >= rhs.data;
+size_t NodeData::hash() const {
+   return std::hash<string>()(data);
 }
 
 //------------------------------ setData -------------------------------------
@@ -51,8 +77,15 @@ bool NodeData::setData(istream& infile) {
    return !infile.eof();       // eof function is true when eof char is read
 }
 
+// set from a character range; assigning into the same string keeps its
+// capacity, so a NodeData reused for many keys seldom allocates
+
+void NodeData::setData(const char* chars, size_t length) {
+   data.assign(chars, length);
+}
+
 //-------------------------- operator<< --------------------------------------
-virtual ostream& operator<<(ostream& output, const NodeData& nd) {
+ostream& operator<<(ostream& output, const NodeData& nd) {
    output << nd.data;
    return output;
 }
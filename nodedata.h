@@ -9,7 +9,7 @@ using namespace std;
 // not necessary to comment further
 
 class NodeData {
-   virtual friend ostream & operator<<(ostream &, const NodeData &);
+   friend ostream & operator<<(ostream &, const NodeData &);
 
 public:
    NodeData();          // default constructor, data is set to an empty string
@@ -22,16 +22,82 @@ public:
    // returns true if the data is set, false when bad data, i.e., is eof
    bool setData(istream&);                
 
-   virtual bool operator==(const NodeData &) const;
+   // set class data to the characters passed, reusing its storage
+   void setData(const char*, size_t);
+
+   // comparisons are not virtual and are defined below, so they can be
+   // inlined into the tree searches
+   bool operator==(const NodeData &) const;
    bool operator!=(const NodeData &) const;
-   virtual bool operator<(const NodeData &) const;
+   bool operator<(const NodeData &) const;
    bool operator>(const NodeData &) const;
    bool operator<=(const NodeData &) const;
    bool operator>=(const NodeData &) const;
 
+   // three way comparison: negative, zero or positive as this is less
+   // than, equal to or greater than the parameter
+   int compare(const NodeData &) const;
+
+   // three way comparison of data that is already known to match in its
+   // first skip characters; stores the length of the common prefix in the
+   // last parameter, so a search can skip it at the next level
+   int compare(const NodeData &, size_t skip, size_t &common) const;
+
+   // first 8 bytes of data packed big endian, zero padded, so comparing
+   // two prefixes as integers orders them the same way as the strings
+   unsigned long long keyPrefix() const;
+
+   // hash of data; equal NodeDatas have equal hashes
+   size_t hash() const;
+
+   // the characters of data and how many there are, so a key can be
+   // written out, or compared where it lies, without making a string
+   const char* chars() const;
+   size_t length() const;
+
 protected:
    string data;          
 };
 
+//------------------------------ compare -------------------------------------
+inline int NodeData::compare(const NodeData& rhs) const {
+   return data.compare(rhs.data);
+}
+
+//---------------------------- chars, length --------------------------------
+inline const char* NodeData::chars() const {
+   return data.data();
+}
+
+inline size_t NodeData::length() const {
+   return data.size();
+}
+
+//------------------------- operator==,!= ------------------------------------
+inline bool NodeData::operator==(const NodeData& rhs) const {
+   return data == rhs.data;
+}
+
+inline bool NodeData::operator!=(const NodeData& rhs) const {
+   return data != rhs.data;
+}
+
+//------------------------ operator<,>,<=,>= ---------------------------------
+inline bool NodeData::operator<(const NodeData& rhs) const {
+   return data < rhs.data;
+}
+
+inline bool NodeData::operator>(const NodeData& rhs) const {
+   return data > rhs.data;
+}
+
+inline bool NodeData::operator<=(const NodeData& rhs) const {
+   return data <= rhs.data;
+}
+
+inline bool NodeData::operator>=(const NodeData& rhs) const {
+   return data >= rhs.data;
+}
+
 #endif
 
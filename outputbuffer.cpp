@@ -0,0 +1,173 @@
+//-----------------------------------------------------------------------//
+// OUTPUTBUFFER.CPP                                                      //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// OutputBuffer gathers small pieces of output into one fixed block and  //
+// hands them to a sink in large chunks                                  //
+//-----------------------------------------------------------------------//
+// Sinks:  a file descriptor, an ostream or a string; see outputbuffer.h //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- a write(2) that writes part of a chunk, or is interrupted by a   //
+//      signal, is retried for the rest                                  //
+//-----------------------------------------------------------------------//
+
+#include "outputbuffer.h"
+#include <cstring>
+#include <algorithm>
+#include <cerrno>
+#include <unistd.h>
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting a file descriptor open for writing
+// Preconditions:   the descriptor stays open while the buffer lives
+// Postconditions:
+//       -- an empty buffer writing to the descriptor is created
+OutputBuffer::OutputBuffer(int toWrite) {
+	start(DESCRIPTOR);
+	descriptor = toWrite;
+}
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting an ostream
+// Preconditions:   the stream outlives the buffer
+// Postconditions:
+//       -- an empty buffer writing to the stream is created
+OutputBuffer::OutputBuffer(ostream& toWrite) {
+	start(STREAM);
+	out = &toWrite;
+}
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting a string to append to
+// Preconditions:   the string outlives the buffer
+// Postconditions:
+//       -- an empty buffer appending to the string is created
+OutputBuffer::OutputBuffer(string& toAppend) {
+	start(TEXT);
+	text = &toAppend;
+}
+
+//------------------------------  start  ----------------------------------
+// helper for the constructors; sets up an empty buffer for a sink
+// Preconditions:   none
+// Postconditions:  none
+void OutputBuffer::start(Sink kind) {
+	sink = kind;
+	descriptor = -1;
+	out = NULL;
+	text = NULL;
+	block = new char[CAPACITY];
+	used = 0;
+	failed = false;
+}
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class OutputBuffer
+// Preconditions:   none
+// Postconditions:
+//       -- what is buffered is written to the sink
+OutputBuffer::~OutputBuffer() {
+	flush();
+	delete[] block;
+}
+
+//-------------------------------- put ------------------------------------
+// Adds characters to the output; ones that do not fit in what is left of
+// the block flush it first, and ones that would fill it all go straight
+// to the sink
+// Preconditions:   the size_t is the number of characters
+// Postconditions:  none
+void OutputBuffer::put(const char* chars, size_t length) {
+	if (length > CAPACITY - used)
+		flush();
+	if (length >= CAPACITY)
+		drain(chars, length);
+	else {
+		memcpy(block + used, chars, length);
+		used += length;
+	}
+}
+
+//-------------------------------- put ------------------------------------
+// Adds one character to the output
+// Preconditions:   none
+// Postconditions:  none
+void OutputBuffer::put(char c) {
+	if (used == CAPACITY)
+		flush();
+	block[used++] = c;
+}
+
+//-------------------------------- put ------------------------------------
+// Adds the characters of a NodeData to the output, as operator<< prints
+// them
+// Preconditions:   none
+// Postconditions:  none
+void OutputBuffer::put(const NodeData& data) {
+	put(data.chars(), data.length());
+}
+
+//------------------------------- spaces ----------------------------------
+// Adds a number of spaces to the output, a block at a time
+// Preconditions:   none
+// Postconditions:  none
+void OutputBuffer::spaces(size_t count) {
+	while (count > 0) {
+		if (used == CAPACITY)
+			flush();
+		size_t some = min(count, CAPACITY - used);
+		memset(block + used, ' ', some);
+		used += some;
+		count -= some;
+	}
+}
+
+//------------------------------- flush -----------------------------------
+// Writes what is buffered to the sink, returns false if any write to
+// the sink has failed
+// Preconditions:   none
+// Postconditions:  the buffer is empty
+bool OutputBuffer::flush() {
+	if (used > 0)
+		drain(block, used);
+	used = 0;
+	return !failed;
+}
+
+//-------------------------------- good -----------------------------------
+// Returns true if no write to the sink has failed
+// Preconditions:   none
+// Postconditions:  none
+bool OutputBuffer::good() const {
+	return !failed;
+}
+
+//------------------------------  drain  ----------------------------------
+// writes characters to the sink, all of them unless a write fails
+// Preconditions:   none
+// Postconditions:  failed is set if a write failed
+void OutputBuffer::drain(const char* chars, size_t length) {
+	if (failed)
+		return;
+	if (sink == TEXT)
+		text->append(chars, length);
+	else if (sink == STREAM) {
+		out->write(chars, length);
+		failed = out->fail();
+	} else {
+		while (length > 0) {
+			ssize_t wrote = write(descriptor, chars, length);
+			if (wrote < 0 && errno == EINTR)
+				continue;
+			if (wrote <= 0) {
+				failed = true;
+				return;
+			}
+			chars += wrote;
+			length -= wrote;
+		}
+	}
+}
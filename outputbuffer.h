@@ -0,0 +1,133 @@
+//-----------------------------------------------------------------------//
+// OUTPUTBUFFER.H                                                        //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// OutputBuffer gathers small pieces of output into one fixed block and  //
+// hands them to a sink in large chunks                                  //
+//-----------------------------------------------------------------------//
+// Sinks:  a file descriptor, written with write(2); an ostream, written //
+//       with ostream::write; or a string, appended to.                  //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- the block holds CAPACITY bytes and is the only memory the buffer //
+//      uses, so a whole tree goes out through the same few kilobytes    //
+//   -- a piece larger than the block goes to the sink directly          //
+//   -- nothing is formatted by a stream: a NodeData goes out as its     //
+//      characters, so stream flags such as width do not apply           //
+//   -- the destructor flushes; flush does not flush an ostream sink     //
+//      itself                                                           //
+//   -- a failed write to a descriptor or stream is remembered, and      //
+//      later output is dropped                                          //
+//   -- the buffer cannot be copied                                      //
+//-----------------------------------------------------------------------//
+
+#ifndef OUTPUTBUFFER_H
+#define OUTPUTBUFFER_H
+#include <iostream>
+#include <string>
+#include <cstddef>
+#include "nodedata.h"
+using namespace std;
+
+
+class OutputBuffer {
+public:
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting a file descriptor open for writing
+// Preconditions:   the descriptor stays open while the buffer lives
+// Postconditions:
+//       -- an empty buffer writing to the descriptor is created
+explicit OutputBuffer(int);
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting an ostream
+// Preconditions:   the stream outlives the buffer
+// Postconditions:
+//       -- an empty buffer writing to the stream is created
+explicit OutputBuffer(ostream&);
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting a string to append to
+// Preconditions:   the string outlives the buffer
+// Postconditions:
+//       -- an empty buffer appending to the string is created
+explicit OutputBuffer(string&);
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class OutputBuffer
+// Preconditions:   none
+// Postconditions:
+//       -- what is buffered is written to the sink
+~OutputBuffer();
+
+//-------------------------------- put ------------------------------------
+// Adds characters to the output
+// Preconditions:   the size_t is the number of characters
+// Postconditions:  none
+void put(const char*, size_t);
+
+//-------------------------------- put ------------------------------------
+// Adds one character to the output
+// Preconditions:   none
+// Postconditions:  none
+void put(char);
+
+//-------------------------------- put ------------------------------------
+// Adds the characters of a NodeData to the output, as operator<< prints
+// them
+// Preconditions:   none
+// Postconditions:  none
+void put(const NodeData&);
+
+//------------------------------- spaces ----------------------------------
+// Adds a number of spaces to the output
+// Preconditions:   none
+// Postconditions:  none
+void spaces(size_t);
+
+//------------------------------- flush -----------------------------------
+// Writes what is buffered to the sink, returns false if any write to
+// the sink has failed
+// Preconditions:   none
+// Postconditions:  the buffer is empty
+bool flush();
+
+//-------------------------------- good -----------------------------------
+// Returns true if no write to the sink has failed
+// Preconditions:   none
+// Postconditions:  none
+bool good() const;
+
+private:
+OutputBuffer(const OutputBuffer&);            //not copyable
+OutputBuffer& operator=(const OutputBuffer&); //not assignable
+
+static const size_t CAPACITY = 1 << 16; //bytes gathered before a write
+
+enum Sink {DESCRIPTOR, STREAM, TEXT};
+
+Sink sink;          //where the output goes
+int descriptor;     //the descriptor, if sink is DESCRIPTOR
+ostream* out;       //the stream, if sink is STREAM
+string* text;       //the string, if sink is TEXT
+char* block;        //CAPACITY bytes of output waiting to be written
+size_t used;        //bytes of block in use
+bool failed;        //a write to the sink has failed
+
+//------------------------------  start  ----------------------------------
+// helper for the constructors; sets up an empty buffer for a sink
+// Preconditions:   none
+// Postconditions:  none
+void start(Sink);
+
+//------------------------------  drain  ----------------------------------
+// writes characters to the sink, all of them unless a write fails
+// Preconditions:   none
+// Postconditions:  failed is set if a write failed
+void drain(const char*, size_t);
+
+};
+
+#endif
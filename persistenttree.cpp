@@ -0,0 +1,118 @@
+//-----------------------------------------------------------------------//
+// PERSISTENTTREE.CPP                                                    //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// PersistentTree is one version of a tree of strings; inserting makes a //
+// new version and leaves this one as it was                             //
+//-----------------------------------------------------------------------//
+// Path copying:  a new version copies the Nodes on the path its insert  //
+//       searched and shares every other subtree with the version it was //
+//       made from, so each version costs O(log n) Nodes.                //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- a version's BinTree is never written once the version has been   //
+//      returned, so every version stays as it was made                  //
+//-----------------------------------------------------------------------//
+
+#include "persistenttree.h"
+
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class PersistentTree
+// Preconditions:   none
+// Postconditions:
+//       -- an empty version is created
+PersistentTree::PersistentTree()
+	: tree(BinTree::AVL, BinTree::COPY_ON_WRITE) {
+}
+
+//------------------------------ insert -----------------------------------
+// Returns a new version holding a copy of the object as well as
+// everything in this one; copying this version shares its root, and the
+// insert into the copy copies the Nodes on its path
+// Preconditions:   none
+// Postconditions:  if the object is already here, the version returned
+//       is an O(1) copy of this one
+PersistentTree PersistentTree::insert(const NodeData& toInsert) const {
+	PersistentTree next(*this);
+	NodeData* copy = new NodeData(toInsert);
+	if (!next.tree.insert(copy)) //already in this version
+		delete copy;
+	return next;
+}
+
+//---------------------------- retrieve -----------------------------------
+// Retrieve a NodeData* of a given object in this version, return true if
+// found
+// Preconditions:   none
+// Postconditions:  the second parameter points to the version's copy if
+//       found; no reassignment of ptr is made otherwise
+bool PersistentTree::retrieve(const NodeData& toFind,
+							  const NodeData*& ptr) const {
+	NodeData* found;
+	if (!tree.retrieve(toFind, found))
+		return false;
+	ptr = found;
+	return true;
+}
+
+//------------------------------ getDepth ---------------------------------
+// Returns the depth of a given value in this version, the root being 1,
+// or 0 if it is not in it
+// Preconditions:   none
+// Postconditions:  none
+int PersistentTree::getDepth(const NodeData& toFind) const {
+	return tree.getDepth(toFind);
+}
+
+//----------------------------- isEmpty -----------------------------------
+// Returns true if this version holds no NodeDatas
+// Preconditions:   none
+// Postconditions:  none
+bool PersistentTree::isEmpty() const {
+	return tree.isEmpty();
+}
+
+//-------------------------------- size -----------------------------------
+// Returns the number of NodeDatas in this version
+// Preconditions:   none
+// Postconditions:  none
+int PersistentTree::size() const {
+	return tree.size();
+}
+
+//------------------------- displaySideways -------------------------------
+// Displays this version as though you are viewing it from the side; hard
+// coded displaying to standard output.
+// Preconditions:   none
+// Postconditions:  none
+void PersistentTree::displaySideways() const {
+	tree.displaySideways();
+}
+
+//-----------------------------  ==  --------------------------------------
+// Determine if two versions hold equal NodeDatas, whatever their shapes,
+// as BinTree's operator== does
+// Preconditions:   none
+// Postconditions:  none
+bool PersistentTree::operator==(const PersistentTree& rhs) const {
+	return tree == rhs.tree;
+}
+
+//-----------------------------  !=  --------------------------------------
+// Determine if two versions hold different NodeDatas
+// Preconditions:   none
+// Postconditions:  none
+bool PersistentTree::operator!=(const PersistentTree& rhs) const {
+	return tree != rhs.tree;
+}
+
+//-----------------------------  <<  --------------------------------------
+// Overloaded output operator for class PersistentTree
+// Preconditions:   NodeData has a working output operator overload
+// Postconditions:  prints an in order traversal of this version,
+//       formatted as BinTree's
+ostream& operator<<(ostream& out, const PersistentTree& toPrint) {
+	return out << toPrint.tree;
+}
@@ -0,0 +1,108 @@
+//-----------------------------------------------------------------------//
+// PERSISTENTTREE.H                                                      //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// PersistentTree is one version of a tree of strings; inserting makes a //
+// new version and leaves this one as it was                             //
+//-----------------------------------------------------------------------//
+// Path copying:  a new version copies the Nodes on the path its insert  //
+//       searched and shares every other subtree with the version it was //
+//       made from, so each version costs O(log n) Nodes.                //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- a version is an AVL BinTree built with BinTree::COPY_ON_WRITE;   //
+//      insert copies it, which shares its root, then inserts into the   //
+//      copy, which copies the shared Nodes on the path                  //
+//   -- a Node is reference counted and freed once no version holds it   //
+//   -- versions are values: copying or assigning one is O(1), and the   //
+//      versions made from one another may be read and dropped from      //
+//      different threads                                                //
+//-----------------------------------------------------------------------//
+
+#ifndef PERSISTENTTREE_H
+#define PERSISTENTTREE_H
+#include <iostream>
+#include "nodedata.h"
+#include "bintree.h"
+using namespace std;
+
+
+class PersistentTree {
+//-----------------------------  <<  --------------------------------------
+// Overloaded output operator for class PersistentTree
+// Preconditions:   NodeData has a working output operator overload
+// Postconditions:  prints an in order traversal of this version,
+//       formatted as BinTree's
+friend ostream& operator<<(ostream&, const PersistentTree&);
+
+public:
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class PersistentTree
+// Preconditions:   none
+// Postconditions:
+//       -- an empty version is created
+PersistentTree();
+
+//------------------------------ insert -----------------------------------
+// Returns a new version holding a copy of the object as well as
+// everything in this one; this version is unchanged
+// Preconditions:   none
+// Postconditions:  if the object is already here, the version returned
+//       is an O(1) copy of this one
+PersistentTree insert(const NodeData&) const;
+
+//---------------------------- retrieve -----------------------------------
+// Retrieve a NodeData* of a given object in this version, return true if
+// found
+// Preconditions:   none
+// Postconditions:  the second parameter points to the version's copy if
+//       found; no reassignment of ptr is made otherwise
+bool retrieve(const NodeData&, const NodeData*&) const;
+
+//------------------------------ getDepth ---------------------------------
+// Returns the depth of a given value in this version, the root being 1,
+// or 0 if it is not in it
+// Preconditions:   none
+// Postconditions:  none
+int getDepth(const NodeData&) const;
+
+//----------------------------- isEmpty -----------------------------------
+// Returns true if this version holds no NodeDatas
+// Preconditions:   none
+// Postconditions:  none
+bool isEmpty() const;
+
+//-------------------------------- size -----------------------------------
+// Returns the number of NodeDatas in this version
+// Preconditions:   none
+// Postconditions:  none
+int size() const;
+
+//------------------------- displaySideways -------------------------------
+// Displays this version as though you are viewing it from the side; hard
+// coded displaying to standard output.
+// Preconditions:   none
+// Postconditions:  none
+void displaySideways() const;
+
+//-----------------------------  ==  --------------------------------------
+// Determine if two versions hold equal NodeDatas, whatever their shapes,
+// as BinTree's operator== does
+// Preconditions:   none
+// Postconditions:  none
+bool operator==(const PersistentTree&) const;
+
+//-----------------------------  !=  --------------------------------------
+// Determine if two versions hold different NodeDatas
+// Preconditions:   none
+// Postconditions:  none
+bool operator!=(const PersistentTree&) const;
+
+private:
+BinTree tree;       //this version; only ever written before it is returned
+
+};
+
+#endif
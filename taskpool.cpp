@@ -0,0 +1,201 @@
+//-----------------------------------------------------------------------//
+// TASKPOOL.CPP                                                          //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// TaskPool is a work-stealing pool of threads for fork-join recursion   //
+//-----------------------------------------------------------------------//
+// Work stealing:  every worker has its own queue of tasks.  A thread    //
+//       forking work pushes it on the back of its own queue and takes   //
+//       from the back again; an idle worker steals from the front of    //
+//       another queue.                                                  //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- a worker remembers its pool and queue in thread_locals           //
+//   -- a worker only sleeps when no queue holds a task                  //
+//-----------------------------------------------------------------------//
+
+#include "taskpool.h"
+
+static thread_local const TaskPool* workerPool = NULL; //pool of this thread
+static thread_local int workerQueue = -1;             //its queue in there
+
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class TaskPool; one worker per core besides the
+// calling thread's
+// Preconditions:   none
+// Postconditions:
+//       -- the workers are started and waiting for work
+TaskPool::TaskPool() {
+	int cores = (int)thread::hardware_concurrency();
+	start(cores > 1 ? cores - 1 : 0);
+}
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the number of workers
+// Preconditions:   the int is not negative
+// Postconditions:
+//       -- the workers are started and waiting for work
+TaskPool::TaskPool(int workerTotal) {
+	start(workerTotal);
+}
+
+//------------------------------  start  ----------------------------------
+// helper for the constructors; starts the workers
+// Preconditions:   the int is not negative
+// Postconditions:  none
+void TaskPool::start(int workerTotal) {
+	queueCount = workerTotal + 1;
+	queues = new Queue[queueCount];
+	stopping = false;
+	queued = 0;
+	for (int i = 0; i < workerTotal; i++)
+		workers.push_back(thread(&TaskPool::workerLoop, this, i));
+}
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class TaskPool
+// Preconditions:   no forkJoin is running on the pool
+// Postconditions:
+//       -- every worker has been stopped and joined
+TaskPool::~TaskPool() {
+	{
+		lock_guard<mutex> hold(sleepLock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (size_t i = 0; i < workers.size(); i++)
+		workers[i].join();
+	delete[] queues;
+}
+
+//------------------------------ forkJoin ---------------------------------
+// Runs two tasks, the second possibly on another thread, and returns
+// once both are done.  The second is queued before the first is run;
+// waiting for it means taking tasks, which finds it again at the back of
+// this thread's queue unless a worker stole it
+// Preconditions:   the tasks do not depend on each other
+// Postconditions:  both tasks have run; an exception from either is
+//       rethrown, after both are done
+void TaskPool::forkJoin(const function<void()>& first,
+						const function<void()>& second) {
+	if (workers.empty()) {
+		first();
+		second();
+		return;
+	}
+	Task forked;
+	forked.work = &second;
+	forked.done = false;
+	int home = homeQueue();
+	push(home, &forked);
+	exception_ptr firstError;
+	try {
+		first();
+	} catch (...) {
+		firstError = current_exception(); //forked must finish first
+	}
+	while (!forked.done.load(memory_order_acquire)) {
+		Task* other = take(home);
+		if (other != NULL)
+			run(other);
+		else
+			this_thread::yield();
+	}
+	if (firstError)
+		rethrow_exception(firstError);
+	if (forked.error)
+		rethrow_exception(forked.error);
+}
+
+//---------------------------- workerCount --------------------------------
+// Returns the number of worker threads
+// Preconditions:   none
+// Postconditions:  none
+int TaskPool::workerCount() const {
+	return (int)workers.size();
+}
+
+//----------------------------  homeQueue  --------------------------------
+// returns the queue the calling thread pushes its forks on: its own if it
+// is one of this pool's workers, the outside threads' otherwise
+// Preconditions:   none
+// Postconditions:  none
+int TaskPool::homeQueue() const {
+	return workerPool == this ? workerQueue : queueCount - 1;
+}
+
+//------------------------------  push  -----------------------------------
+// puts a task on the back of a queue and wakes a worker; the sleep lock
+// is taken so a worker about to sleep cannot miss the task
+// Preconditions:   none
+// Postconditions:  none
+void TaskPool::push(int index, Task* task) {
+	{
+		lock_guard<mutex> hold(queues[index].lock);
+		queues[index].tasks.push_back(task);
+	}
+	{
+		lock_guard<mutex> hold(sleepLock);
+		queued++;
+	}
+	wake.notify_one();
+}
+
+//------------------------------  take  -----------------------------------
+// takes the newest task of a queue, or else steals the oldest task of
+// another, trying them in turn from the next one on
+// Preconditions:   none
+// Postconditions:  returns NULL if every queue is empty
+TaskPool::Task* TaskPool::take(int home) {
+	for (int i = 0; i < queueCount; i++) {
+		Queue& queue = queues[(home + i) % queueCount];
+		lock_guard<mutex> hold(queue.lock);
+		if (!queue.tasks.empty()) {
+			Task* task;
+			if (i == 0) {
+				task = queue.tasks.back();
+				queue.tasks.pop_back();
+			} else {
+				task = queue.tasks.front();
+				queue.tasks.pop_front();
+			}
+			queued--;
+			return task;
+		}
+	}
+	return NULL;
+}
+
+//-------------------------------  run  -----------------------------------
+// runs a task and marks it done, keeping what it throws
+// Preconditions:   none
+// Postconditions:  none
+void TaskPool::run(Task* task) {
+	try {
+		(*task->work)();
+	} catch (...) {
+		task->error = current_exception();
+	}
+	task->done.store(true, memory_order_release);
+}
+
+//----------------------------  workerLoop  -------------------------------
+// body of a worker thread; runs tasks until the pool stops, sleeping
+// whenever no queue holds one
+// Preconditions:   the int is the worker's queue
+// Postconditions:  none
+void TaskPool::workerLoop(int index) {
+	workerPool = this;
+	workerQueue = index;
+	while (!stopping) {
+		Task* task = take(index);
+		if (task != NULL) {
+			run(task);
+			continue;
+		}
+		unique_lock<mutex> hold(sleepLock);
+		wake.wait(hold, [this]() { return stopping || queued > 0; });
+	}
+}
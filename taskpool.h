@@ -0,0 +1,140 @@
+//-----------------------------------------------------------------------//
+// TASKPOOL.H                                                            //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// TaskPool is a work-stealing pool of threads for fork-join recursion   //
+//-----------------------------------------------------------------------//
+// Work stealing:  every worker has its own queue of tasks.  A thread    //
+//       forking work pushes it on the back of its own queue and takes   //
+//       from the back again, so it mostly runs its own most recent      //
+//       forks; an idle worker steals from the front of another queue,   //
+//       which holds the oldest, and so the largest, pieces of work.     //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- forkJoin runs the first task itself and offers the second to the //
+//      pool; while it waits for the second it runs other queued tasks,  //
+//      so a nested forkJoin never blocks a worker                       //
+//   -- threads outside the pool share one extra queue                   //
+//   -- a pool with no workers runs both tasks on the calling thread     //
+//   -- an exception thrown by a task is rethrown by its forkJoin        //
+//   -- the pool cannot be copied, and may only be destroyed once no     //
+//      forkJoin is running on it                                        //
+//-----------------------------------------------------------------------//
+
+#ifndef TASKPOOL_H
+#define TASKPOOL_H
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+using namespace std;
+
+
+class TaskPool {
+public:
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class TaskPool; one worker per core besides the
+// calling thread's
+// Preconditions:   none
+// Postconditions:
+//       -- the workers are started and waiting for work
+TaskPool();
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the number of workers
+// Preconditions:   the int is not negative
+// Postconditions:
+//       -- the workers are started and waiting for work
+explicit TaskPool(int);
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class TaskPool
+// Preconditions:   no forkJoin is running on the pool
+// Postconditions:
+//       -- every worker has been stopped and joined
+~TaskPool();
+
+//------------------------------ forkJoin ---------------------------------
+// Runs two tasks, the second possibly on another thread, and returns
+// once both are done
+// Preconditions:   the tasks do not depend on each other
+// Postconditions:  both tasks have run; an exception from either is
+//       rethrown, after both are done
+void forkJoin(const function<void()>&, const function<void()>&);
+
+//---------------------------- workerCount --------------------------------
+// Returns the number of worker threads
+// Preconditions:   none
+// Postconditions:  none
+int workerCount() const;
+
+private:
+TaskPool(const TaskPool&);            //not copyable
+TaskPool& operator=(const TaskPool&); //not assignable
+
+struct Task {
+	const function<void()>* work;  //what to run; owned by the forker
+	atomic<bool> done;             //set once work has returned
+	exception_ptr error;           //what work threw, if it did
+};
+
+struct alignas(64) Queue {         //one cache line each, so workers
+	mutex lock;                    //taking from their own queues do not
+	deque<Task*> tasks;            //contend for a line
+};
+
+vector<thread> workers;   //the worker threads
+Queue* queues;            //one per worker, then the outside threads' one
+int queueCount;           //workers + 1
+atomic<bool> stopping;    //set by the destructor
+atomic<int> queued;       //tasks waiting in every queue together
+mutex sleepLock;          //guards sleeping on wake
+condition_variable wake;  //idle workers wait on it for tasks
+
+//------------------------------  start  ----------------------------------
+// helper for the constructors; starts the workers
+// Preconditions:   the int is not negative
+// Postconditions:  none
+void start(int);
+
+//----------------------------  homeQueue  --------------------------------
+// returns the queue the calling thread pushes its forks on: its own if it
+// is one of this pool's workers, the outside threads' otherwise
+// Preconditions:   none
+// Postconditions:  none
+int homeQueue() const;
+
+//------------------------------  push  -----------------------------------
+// puts a task on the back of a queue and wakes a worker
+// Preconditions:   none
+// Postconditions:  none
+void push(int, Task*);
+
+//------------------------------  take  -----------------------------------
+// takes the newest task of a queue, or else steals the oldest task of
+// another
+// Preconditions:   none
+// Postconditions:  returns NULL if every queue is empty
+Task* take(int);
+
+//-------------------------------  run  -----------------------------------
+// runs a task and marks it done, keeping what it throws
+// Preconditions:   none
+// Postconditions:  none
+static void run(Task*);
+
+//----------------------------  workerLoop  -------------------------------
+// body of a worker thread; runs tasks until the pool stops
+// Preconditions:   the int is the worker's queue
+// Postconditions:  none
+void workerLoop(int);
+
+};
+
+#endif
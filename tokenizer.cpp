@@ -0,0 +1,219 @@
+//-----------------------------------------------------------------------//
+// TOKENIZER.CPP                                                         //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// Tokenizer splits large blocks of text into whitespace separated       //
+// tokens, a batch at a time, for feeding trees                          //
+//-----------------------------------------------------------------------//
+// Records:  each ended by the token "$$"; see tokenizer.h.              //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- a batch never spans two blocks, so the block can be refilled     //
+//      between batches without moving a Token still in use              //
+//-----------------------------------------------------------------------//
+
+#include "tokenizer.h"
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static const unsigned long long ONES = ~0ULL / 255; //0x0101...01
+
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class Tokenizer
+// Preconditions:   none
+// Postconditions:
+//       -- a Tokenizer with no input is created; open gives it some
+Tokenizer::Tokenizer() {
+	in = NULL;
+	mapping = NULL;
+	release();
+}
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the stream to read blocks from
+// Preconditions:   the stream outlives the Tokenizer, and is read by
+//       nothing else while the Tokenizer is in use
+// Postconditions:
+//       -- nothing is read until the first batch is asked for
+Tokenizer::Tokenizer(istream& source) {
+	in = NULL;
+	mapping = NULL;
+	release();
+	in = &source;
+	block.resize(BLOCKSIZE);
+	cursor = limit = &block[0];
+	exhausted = false;
+}
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class Tokenizer
+// Preconditions:   none
+// Postconditions:
+//       -- the block is deallocated, or the file unmapped
+Tokenizer::~Tokenizer() {
+	release();
+}
+
+//-------------------------------- open -----------------------------------
+// Maps a file to be tokenized in place, returns true if successful; the
+// kernel is told it will be read front to back
+// Preconditions:   the file is not changed while it is mapped
+// Postconditions:  the Tokenizer reads the file from its start; on
+//       false it has no input
+bool Tokenizer::open(const char* path) {
+	release();
+	int file = ::open(path, O_RDONLY);
+	if (file < 0)
+		return false;
+	struct stat status;
+	if (fstat(file, &status) != 0) {
+		::close(file);
+		return false;
+	}
+	size_t bytes = (size_t)status.st_size;
+	if (bytes == 0) { //mmap refuses an empty file; there is nothing to read
+		::close(file);
+		return true;
+	}
+	void* mapped = mmap(NULL, bytes, PROT_READ, MAP_PRIVATE, file, 0);
+	::close(file); //the mapping keeps the file open
+	if (mapped == MAP_FAILED)
+		return false;
+	madvise(mapped, bytes, MADV_SEQUENTIAL);
+	mapping = mapped;
+	mappedBytes = bytes;
+	cursor = (const char*)mapped;
+	limit = cursor + bytes;
+	return true;
+}
+
+//------------------------------  release  --------------------------------
+// lets go of the input
+// Preconditions:   none
+// Postconditions:  the Tokenizer has no input
+void Tokenizer::release() {
+	if (mapping != NULL)
+		munmap(mapping, mappedBytes);
+	in = NULL;
+	vector<char>().swap(block);
+	mapping = NULL;
+	mappedBytes = 0;
+	cursor = limit = NULL;
+	exhausted = true;
+	recordEnded = false;
+}
+
+//----------------------------- nextBatch ---------------------------------
+// Replaces the contents of the vector with the next tokens of the
+// current record and returns how many there are; 0 means the record is
+// over.  Returns early rather than refill the block under Tokens it has
+// already handed back
+// Preconditions:   none
+// Postconditions:  the Tokens are valid until the next call
+size_t Tokenizer::nextBatch(vector<Token>& batch) {
+	batch.clear();
+	if (recordEnded) { //the last batch ran up to this record's "$$"
+		recordEnded = false;
+		return 0;
+	}
+	for (;;) {
+		while (cursor < limit && isSpace(*cursor))
+			cursor++;
+		if (cursor == limit) {
+			if (!batch.empty())
+				return batch.size();
+			if (!refill())
+				return 0; //the input ran out inside the record
+			continue;
+		}
+		const char* end = tokenEnd(cursor, limit);
+		if (end == limit && !exhausted) { //the token may go on
+			if (!batch.empty())
+				return batch.size();
+			refill();
+			continue;
+		}
+		Token token;
+		token.chars = cursor;
+		token.length = end - cursor;
+		cursor = end;
+		if (token.length == 2 && token.chars[0] == '$' &&
+			token.chars[1] == '$') {
+			if (batch.empty())
+				return 0;
+			recordEnded = true;
+			return batch.size();
+		}
+		batch.push_back(token);
+		if (batch.size() == BATCHSIZE)
+			return batch.size();
+	}
+}
+
+//------------------------------- atEnd -----------------------------------
+// Returns true if every character of the input has been tokenized
+// Preconditions:   none
+// Postconditions:  none
+bool Tokenizer::atEnd() const {
+	return exhausted && cursor == limit && !recordEnded;
+}
+
+//------------------------------  refill  ---------------------------------
+// moves the characters not yet tokenized to the front of the block and
+// reads the stream into the rest, growing the block if they fill it.  A
+// mapped file is read in full already
+// Preconditions:   no Token handed back is still in use
+// Postconditions:  returns false if nothing more could be read
+bool Tokenizer::refill() {
+	if (exhausted)
+		return false;
+	size_t kept = limit - cursor;
+	memmove(&block[0], cursor, kept);
+	if (kept == block.size()) //one token fills the block
+		block.resize(2 * block.size());
+	in->read(&block[kept], block.size() - kept);
+	size_t got = (size_t)in->gcount();
+	if (got < block.size() - kept)
+		exhausted = true;
+	cursor = &block[0];
+	limit = cursor + kept + got;
+	return got > 0;
+}
+
+//----------------------------  tokenEnd  ---------------------------------
+// returns the first whitespace character from the first pointer on, or
+// the second pointer if there is none.  A word with no byte below 0x21
+// holds no whitespace and is skipped whole; the test only misfires on
+// bytes above one that is below, so it never skips whitespace, and a
+// word it flags is looked at byte by byte
+// Preconditions:   the first pointer is not past the second
+// Postconditions:  none
+const char* Tokenizer::tokenEnd(const char* from, const char* to) {
+	while (to - from >= 8) {
+		unsigned long long word;
+		memcpy(&word, from, 8);
+		if (((word - ONES * 0x21) & ~word & ONES * 0x80) != 0) {
+			for (int i = 0; i < 8; i++) //a control character, or a space
+				if (isSpace(from[i]))
+					return from + i;
+		}
+		from += 8;
+	}
+	while (from < to && !isSpace(*from))
+		from++;
+	return from;
+}
+
+//-----------------------------  isSpace  ---------------------------------
+// returns true if the character is whitespace: a space, or one of tab,
+// newline, vertical tab, form feed and carriage return
+// Preconditions:   none
+// Postconditions:  none
+bool Tokenizer::isSpace(char c) {
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
@@ -0,0 +1,136 @@
+//-----------------------------------------------------------------------//
+// TOKENIZER.H                                                           //
+// Author: Luke Selbeck                                                  //
+// Date: October 18th, 2026                                              //
+// Class: CSS 343                                                        //
+//                                                                       //
+// Tokenizer splits large blocks of text into whitespace separated       //
+// tokens, a batch at a time, for feeding trees                          //
+//-----------------------------------------------------------------------//
+// Records:  the input is a sequence of records, each ended by the token //
+//       "$$" as operator>> expects.  nextBatch hands back the tokens of //
+//       the current record a batch at a time and 0 once the record is   //
+//       over; the call after that starts on the next record.            //
+//                                                                       //
+// Implementation and assumptions:                                       //
+//   -- a Token points into the Tokenizer's block and is only valid      //
+//      until the next call to nextBatch; nothing is copied per token    //
+//   -- a stream is read in blocks of BLOCKSIZE bytes with one read()    //
+//      each; a token cut by the end of a block is moved to the front    //
+//      before the next is read, and the block grows to fit a token      //
+//      longer than it.  The stream is read ahead of the record being    //
+//      tokenized, so the rest of it belongs to the Tokenizer            //
+//   -- open maps a whole file with mmap instead, and tokenizes it in    //
+//      place with no reads at all; POSIX only                           //
+//   -- the end of a token is found 8 bytes at a time: one word test     //
+//      tells whether any of 8 characters can be whitespace, and only    //
+//      then are they looked at one by one                               //
+//   -- whitespace is as isspace has it in the C locale                  //
+//   -- the Tokenizer cannot be copied                                   //
+//-----------------------------------------------------------------------//
+
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+#include <iostream>
+#include <vector>
+#include <cstddef>
+using namespace std;
+
+
+class Tokenizer {
+public:
+struct Token {
+	const char* chars;  //first character, in the Tokenizer's block
+	size_t length;      //characters in the token
+};
+
+//-------------------------- Constructor ----------------------------------
+// Default constructor for class Tokenizer
+// Preconditions:   none
+// Postconditions:
+//       -- a Tokenizer with no input is created; open gives it some
+Tokenizer();
+
+//-------------------------- Constructor ----------------------------------
+// Constructor accepting the stream to read blocks from
+// Preconditions:   the stream outlives the Tokenizer, and is read by
+//       nothing else while the Tokenizer is in use
+// Postconditions:
+//       -- nothing is read until the first batch is asked for
+explicit Tokenizer(istream&);
+
+//--------------------------- Destructor ----------------------------------
+// Destructor for class Tokenizer
+// Preconditions:   none
+// Postconditions:
+//       -- the block is deallocated, or the file unmapped
+~Tokenizer();
+
+//-------------------------------- open -----------------------------------
+// Maps a file to be tokenized in place, returns true if successful
+// Preconditions:   the file is not changed while it is mapped
+// Postconditions:  the Tokenizer reads the file from its start; on
+//       false it has no input
+bool open(const char*);
+
+//----------------------------- nextBatch ---------------------------------
+// Replaces the contents of the vector with the next tokens of the
+// current record, at most BATCHSIZE of them, and returns how many there
+// are.  0 means the record is over: its "$$" was read, or the input ran
+// out
+// Preconditions:   none
+// Postconditions:  the Tokens are valid until the next call
+size_t nextBatch(vector<Token>&);
+
+//------------------------------- atEnd -----------------------------------
+// Returns true if every character of the input has been tokenized
+// Preconditions:   none
+// Postconditions:  none
+bool atEnd() const;
+
+private:
+Tokenizer(const Tokenizer&);            //not copyable
+Tokenizer& operator=(const Tokenizer&); //not assignable
+
+static const size_t BLOCKSIZE = 1 << 20; //bytes read from a stream at once
+static const size_t BATCHSIZE = 1 << 14; //most Tokens in a batch
+
+istream* in;          //stream read from, or NULL
+vector<char> block;   //the stream's current block
+void* mapping;        //the mapped file, or NULL
+size_t mappedBytes;   //its length
+const char* cursor;   //next character to tokenize
+const char* limit;    //end of the characters read so far
+bool exhausted;       //nothing more can be read
+bool recordEnded;     //"$$" was read while a batch was still being handed
+					  //back; the next call reports the end of the record
+
+//------------------------------  refill  ---------------------------------
+// moves the characters not yet tokenized to the front of the block and
+// reads the stream into the rest, growing the block if they fill it
+// Preconditions:   no Token handed back is still in use
+// Postconditions:  returns false if nothing more could be read
+bool refill();
+
+//------------------------------  release  --------------------------------
+// lets go of the input
+// Preconditions:   none
+// Postconditions:  the Tokenizer has no input
+void release();
+
+//----------------------------  tokenEnd  ---------------------------------
+// returns the first whitespace character from the first pointer on, or
+// the second pointer if there is none
+// Preconditions:   the first pointer is not past the second
+// Postconditions:  none
+static const char* tokenEnd(const char*, const char*);
+
+//-----------------------------  isSpace  ---------------------------------
+// returns true if the character is whitespace
+// Preconditions:   none
+// Postconditions:  none
+static bool isSpace(char);
+
+};
+
+#endif